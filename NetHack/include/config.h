@@ -49,6 +49,7 @@
 /* #define QT_GRAPHICS */    /* Qt interface */
 /* #define GNOME_GRAPHICS */ /* Gnome interface */
 /* #define MSWIN_GRAPHICS */ /* Windows NT, CE, Graphics */
+/* #define HEADLESS_GRAPHICS */ /* no display; see "make benchmark" */
 
 /*
  * Define the default window system.  This should be one that is compiled
@@ -299,6 +300,15 @@
 /* # define ZEROCOMP      */ /* Support ZEROCOMP compression */
 /* # define RLECOMP       */ /* Support RLECOMP compression  */
 
+/*
+ *      Defining LZCOMP builds in support for internal LZ77-style block
+ *      compression of all save, level and bones data.  Like ZEROCOMP it
+ *      replaces the data written rather than compressing the finished
+ *      file, but it packs much better and makes COMPRESS's external
+ *      program unnecessary; it is used when the lzcomp option is set.
+ */
+#define LZCOMP /* Support LZCOMP compression */
+
 /*
  *      Data librarian.  Defining DLB places most of the support files into
  *      a tar-like file, thus making a neater installation.  See *conf.h
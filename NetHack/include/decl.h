@@ -388,6 +388,15 @@ E char *fqn_prefix_names[PREFIX_COUNT];
 
 E NEARDATA struct savefile_info sfcap, sfrestinfo, sfsaveinfo;
 
+/* what a save file's game summary (SFI2_SAVEINFO) says about the game */
+struct save_summary {
+    char plname[PL_NSIZ];
+    char role[4], race[4], gender[4], align[4]; /* file codes */
+    char dungeon[BUFSZ];
+    long depth, moves, ulevel, hp, hpmax, savetime;
+    char mode; /* 'D', 'X', or '\0' */
+};
+
 struct opvar {
     xchar spovartyp; /* one of SPOVAR_foo */
     union {
@@ -161,6 +161,7 @@ E void FDECL(status_initialize, (BOOLEAN_P));
 E void NDECL(status_finish);
 E void FDECL(status_notify_windowport, (BOOLEAN_P));
 E void NDECL(status_eval_next_unhilite);
+E void FDECL(bot_bench, (winid));
 #ifdef STATUS_HILITES
 E boolean FDECL(parse_status_hl1, (char *op, BOOLEAN_P));
 E void NDECL(clear_status_hilites);
@@ -346,6 +347,7 @@ E void NDECL(see_traps);
 E void NDECL(curs_on_u);
 E int NDECL(doredraw);
 E void NDECL(docrt);
+E void NDECL(refresh_map);
 E void FDECL(show_glyph, (int, int, int));
 E void NDECL(clear_glyph_buffer);
 E void FDECL(row_refresh, (int, int, int));
@@ -699,6 +701,7 @@ E const char *FDECL(surface, (int, int));
 E const char *FDECL(ceiling, (int, int));
 E struct engr *FDECL(engr_at, (XCHAR_P, XCHAR_P));
 E int FDECL(sengr_at, (const char *, XCHAR_P, XCHAR_P, BOOLEAN_P));
+E boolean FDECL(engr_elbereth_at, (XCHAR_P, XCHAR_P));
 E void FDECL(u_wipe_engr, (int));
 E void FDECL(wipe_engr_at, (XCHAR_P, XCHAR_P, XCHAR_P, BOOLEAN_P));
 E void FDECL(read_engr_at, (int, int));
@@ -750,6 +753,11 @@ E void FDECL(set_levelfile_name, (char *, int));
 E int FDECL(create_levelfile, (int, char *));
 E int FDECL(open_levelfile, (int, char *));
 E void FDECL(delete_levelfile, (int));
+E void FDECL(levelstore_checkpoint, (BOOLEAN_P));
+E void NDECL(levelio_prefetch);
+E void FDECL(attach_levelfile, (int, int));
+E void NDECL(detach_levelfile);
+E void NDECL(free_levelimages);
 E void NDECL(clearlocks);
 E int FDECL(create_bonesfile, (d_level *, char **, char *));
 #ifdef MFLOPPY
@@ -790,6 +798,7 @@ E int FDECL(validate_prefix_locations, (char *));
 #ifdef SELECTSAVED
 E char *FDECL(plname_from_file, (const char *));
 #endif
+E void FDECL(update_saveindex, (struct save_summary *));
 E char **NDECL(get_saved_games);
 E void FDECL(free_saved_games, (char **));
 #ifdef SELF_RECOVER
@@ -912,7 +921,9 @@ E char *FDECL(strstri, (const char *, const char *));
 E boolean
 FDECL(fuzzymatch, (const char *, const char *, const char *, BOOLEAN_P));
 E void NDECL(setrandom);
+E void FDECL(set_random, (unsigned long));
 E time_t NDECL(getnow);
+E long NDECL(cputime_ms);
 E int NDECL(getyear);
 #if 0
 E char *FDECL(yymmdd, (time_t));
@@ -1026,6 +1037,7 @@ E int NDECL(dosuspend);
 E void FDECL(new_light_source, (XCHAR_P, XCHAR_P, int, int, ANY_P *));
 E void FDECL(del_light_source, (int, ANY_P *));
 E void FDECL(do_light_sources, (char **));
+E void FDECL(light_block_changed, (int, int));
 E struct monst *FDECL(find_mid, (unsigned, unsigned));
 E void FDECL(save_light_sources, (int, int, int));
 E void FDECL(restore_light_sources, (int));
@@ -1157,6 +1169,7 @@ E boolean FDECL(usmellmon, (struct permonst *));
 
 E int FDECL(mapglyph, (int, int *, int *, unsigned *, int, int));
 E char *FDECL(encglyph, (int));
+E void FDECL(mapglyph_bench, (winid));
 E void FDECL(genl_putmixed, (winid, int, const char *));
 
 /* ### mcastu.c ### */
@@ -1357,6 +1370,7 @@ E int FDECL(undead_to_corpse, (int));
 E int FDECL(genus, (int, int));
 E int FDECL(pm_to_cham, (int));
 E int FDECL(minliquid, (struct monst *));
+E void NDECL(reset_mready);
 E int NDECL(movemon);
 E int FDECL(meatmetal, (struct monst *));
 E int FDECL(meatobj, (struct monst *));
@@ -1366,12 +1380,16 @@ E int FDECL(curr_mon_load, (struct monst *));
 E int FDECL(max_mon_load, (struct monst *));
 E int FDECL(can_carry, (struct monst *, struct obj *));
 E int FDECL(mfndpos, (struct monst *, coord *, long *, long));
+E void FDECL(mfndpos_bench, (winid));
 E boolean FDECL(monnear, (struct monst *, int, int));
 E void NDECL(dmonsfree);
 E int FDECL(mcalcmove, (struct monst *));
 E void NDECL(mcalcdistress);
 E void FDECL(replmon, (struct monst *, struct monst *));
 E void FDECL(relmon, (struct monst *, struct monst **));
+E void FDECL(mid_index_add, (struct monst *, unsigned));
+E void FDECL(mid_index_del, (struct monst *));
+E struct monst *FDECL(mid_index_find, (unsigned, unsigned));
 E struct obj *FDECL(mlifesaver, (struct monst *));
 E boolean FDECL(corpse_chance, (struct monst *, struct monst *, BOOLEAN_P));
 E void FDECL(mondead, (struct monst *));
@@ -1467,6 +1485,8 @@ E boolean FDECL(monhaskey, (struct monst *, BOOLEAN_P));
 E void FDECL(mon_regen, (struct monst *, BOOLEAN_P));
 E int FDECL(dochugw, (struct monst *));
 E boolean FDECL(onscary, (int, int, struct monst *));
+E boolean FDECL(scary_immune, (struct monst *));
+E boolean FDECL(onscary_spot, (int, int, struct monst *));
 E void FDECL(monflee, (struct monst *, int, BOOLEAN_P, BOOLEAN_P));
 E void FDECL(mon_yells, (struct monst *, const char *));
 E int FDECL(dochug, (struct monst *));
@@ -2056,13 +2076,16 @@ E int FDECL(dorecover, (int));
 E void FDECL(restcemetery, (int, struct cemetery **));
 E void FDECL(trickery, (char *));
 E void FDECL(getlev, (int, int, XCHAR_P, BOOLEAN_P));
-E void FDECL(get_plname_from_file, (int, char *));
+E void FDECL(get_plname_from_file, (int, char *, struct save_summary *));
+E boolean FDECL(get_saveinfo_from_file, (int, struct save_summary *));
 #ifdef SELECTSAVED
 E int FDECL(restore_menu, (winid));
 #endif
 E void NDECL(minit);
 E boolean FDECL(lookup_id_mapping, (unsigned, unsigned *));
+E void FDECL(id_map_stats, (const char *, char *, long *, long *));
 E void FDECL(mread, (int, genericptr_t, unsigned int));
+E void FDECL(mread_image, (int, const char *, unsigned));
 E int FDECL(validate, (int, const char *));
 E void NDECL(reset_restpref);
 E void FDECL(set_restpref, (const char *));
@@ -2080,6 +2103,12 @@ E int FDECL(rnd, (int));
 E int FDECL(d, (int, int));
 E int FDECL(rne, (int));
 E int FDECL(rnz, (int));
+E void FDECL(init_rng, (unsigned long));
+E int FDECL(rng_select, (int));
+E void FDECL(rng_level, (int));
+E void FDECL(save_rng, (int, int));
+E void FDECL(rest_rng, (int));
+E void FDECL(rnd_bench, (winid));
 
 /* ### role.c ### */
 
@@ -2148,16 +2177,24 @@ E void FDECL(bufoff, (int));
 E void FDECL(bflush, (int));
 E void FDECL(bwrite, (int, genericptr_t, unsigned int));
 E void FDECL(bclose, (int));
+E void FDECL(bwrite_image, (int));
+E char *FDECL(bwrite_image_done, (unsigned *));
 E void FDECL(def_bclose, (int));
 #if defined(ZEROCOMP)
 E void FDECL(zerocomp_bclose, (int));
 #endif
+#if defined(LZCOMP)
+E void FDECL(lzcomp_bclose, (int));
+#endif
 E void FDECL(savecemetery, (int, int, struct cemetery **));
 E void FDECL(savefruitchn, (int, int));
 E void FDECL(store_plname_in_file, (int));
+E void FDECL(fill_save_summary, (struct save_summary *));
+E void FDECL(store_saveinfo, (int, struct save_summary *));
 E void NDECL(free_dungeons);
 E void NDECL(freedynamicdata);
 E void FDECL(store_savefileinfo, (int));
+E void FDECL(save_chunk, (int, int, int));
 
 /* ### shk.c ### */
 
@@ -2399,6 +2436,7 @@ E void FDECL(timer_stats, (const char *, char *, long *, long *));
 E void FDECL(relink_timers, (BOOLEAN_P));
 E int NDECL(wiz_timeout_queue);
 E void NDECL(timer_sanity_check);
+E void FDECL(timer_bench, (winid));
 
 /* ### topten.c ### */
 
@@ -2454,6 +2492,7 @@ E boolean FDECL(closeholdingtrap, (struct monst *, boolean *));
 E boolean FDECL(openfallingtrap, (struct monst *, BOOLEAN_P, boolean *));
 E boolean FDECL(chest_trap, (struct obj *, int, BOOLEAN_P));
 E void FDECL(deltrap, (struct trap *));
+E void NDECL(trap_sanity_check);
 E boolean FDECL(delfloortrap, (struct trap *));
 E struct trap *FDECL(t_at, (int, int));
 E void FDECL(b_trapped, (const char *, int));
@@ -2605,6 +2644,7 @@ E void NDECL(vision_init);
 E int FDECL(does_block, (int, int, struct rm *));
 E void NDECL(vision_reset);
 E void FDECL(vision_recalc, (int));
+E void FDECL(vision_stats, (const char *, char *, long *, long *));
 E void FDECL(block_point, (int, int));
 E void FDECL(unblock_point, (int, int));
 E boolean FDECL(clear_path, (int, int, int, int));
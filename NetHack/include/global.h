@@ -290,12 +290,74 @@ struct savefile_info {
 #define SFI1_EXTERNALCOMP (1UL)
 #define SFI1_RLECOMP (1UL << 1)
 #define SFI1_ZEROCOMP (1UL << 2)
+#define SFI1_LZCOMP (1UL << 3)
+#define SFI1_LZVERSION(v) ((unsigned long) (v) << 8)
+#define SFI1_LZVERSMASK (0xfUL << 8)
 #else
 #define SFI1_EXTERNALCOMP (1L)
 #define SFI1_RLECOMP (1L << 1)
 #define SFI1_ZEROCOMP (1L << 2)
+#define SFI1_LZCOMP (1L << 3)
+#define SFI1_LZVERSION(v) ((long) (v) << 8)
+#define SFI1_LZVERSMASK (0xfL << 8)
 #endif
 
+/* message history is saved as one block, introduced by this in place of
+   the first message length */
+#define MSGHIST_BLOCK (-2)
+
+/* sfi2:  SAVEINFO, a tagged game summary follows the player name in a
+           save file; RNGSTATE, the random number generators' state is
+           saved with the game; CHUNKS, the saved data is divided into
+           tagged chunks listed in a table of contents */
+#ifdef NHSTDC
+#define SFI2_SAVEINFO (1UL)
+#define SFI2_RNGSTATE (1UL << 1)
+#define SFI2_CHUNKS (1UL << 2)
+#else
+#define SFI2_SAVEINFO (1L)
+#define SFI2_RNGSTATE (1L << 1)
+#define SFI2_CHUNKS (1L << 2)
+#endif
+
+/*
+ * With SFI2_CHUNKS, the savefile_info of a save, bones or checkpoint
+ * file is followed by a table of contents:  "NHtc" and a 16 bit count,
+ * then for each kind of chunk the file uses, its 4 byte tag and the 32
+ * bit total size of the structures it holds as raw data, all
+ * little-endian.  Each chunk in the (possibly compressed) data starts
+ * with its tag.  See save_chunks[] in save.c.
+ */
+#define CHUNKTOC_ENTSZ 8 /* bytes per table of contents entry */
+#define MAXCHUNKTOC 64    /* more entries than recover will copy */
+
+/*
+ * The game summary is "NHsi", a 16 bit SAVEINFO_VERSION and the 16 bit
+ * length of what follows, all little-endian; then any number of fields,
+ * each a tag byte, a length byte and that many bytes of value.  Numbers
+ * are 32 bit little-endian, strings have no terminator.  Readers skip
+ * tags they don't know, so fields can be added without a new version.
+ */
+#define SAVEINFO_VERSION 1
+#define SI_PLNAME 1   /* player name */
+#define SI_ROLE 2     /* role, race, gender and alignment file codes */
+#define SI_RACE 3
+#define SI_GENDER 4
+#define SI_ALIGN 5
+#define SI_DEPTH 6    /* depth of current level */
+#define SI_DUNGEON 7  /* name of current dungeon */
+#define SI_MOVES 8    /* turn counter */
+#define SI_ULEVEL 9   /* experience level */
+#define SI_HP 10      /* hit points and maximum, as displayed */
+#define SI_HPMAX 11
+#define SI_MODE 12    /* 'D' debug, 'X' explore, or absent */
+#define SI_SAVETIME 13 /* time(), when saved */
+
+/* LZCOMP block format; bump LZCOMP_VERSION whenever it changes */
+#define LZCOMP_VERSION 1
+#define LZBLOCKSZ 16384 /* max. uncompressed bytes per block */
+#define LZMINMATCH 4    /* shortest back reference */
+
 /*
  * Configurable internal parameters.
  *
@@ -55,6 +55,11 @@ enum hunger_state_types {
     STARVED
 };
 
+/* random number streams, see rnd.c */
+#define RNG_CORE 0  /* everything not listed below */
+#define RNG_LEVEL 1 /* level creation */
+#define NUM_RNGS 2
+
 /* Macros for how a rumor was delivered in outrumor() */
 #define BY_ORACLE 0
 #define BY_COOKIE 1
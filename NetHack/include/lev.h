@@ -18,6 +18,48 @@
 #define perform_bwrite(mode) ((mode) & (COUNT_SAVE | WRITE_SAVE))
 #define release_data(mode) ((mode) &FREE_SAVE)
 
+/* kinds of chunk in the saved game state and level data; the order is
+   that of save_chunks[] in save.c (tags and sizes) */
+#define SC_GAME 0  /* uid, context and flags */
+#define SC_HERO 1  /* u and the game's start and play times */
+#define SC_KILR 2  /* killer info */
+#define SC_TIMR 3  /* timers, global or for one level */
+#define SC_LITE 4  /* light sources, likewise */
+#define SC_INVT 5  /* inventory and an orphaned ball & chain */
+#define SC_MIGR 6  /* migrating objects and monsters */
+#define SC_VITL 7  /* mvitals[] */
+#define SC_DUNG 8  /* dungeon structure and overview */
+#define SC_LVCH 9  /* special level chain */
+#define SC_MISC 10 /* turn counters, quest status, spellbook */
+#define SC_ARTI 11 /* artifacts */
+#define SC_ORCL 12 /* oracle consultations */
+#define SC_PLAY 13 /* engulfer and steed ids, pl_character, pl_fruit */
+#define SC_FRUT 14 /* fruit names */
+#define SC_NAME 15 /* object names and discoveries */
+#define SC_WATR 16 /* Plane of Water bubbles and clouds */
+#define SC_RNGS 17 /* random number generators */
+#define SC_MSGH 18 /* message history */
+#define SC_LEVL 19 /* level header, map, stairs, flags and rooms */
+#define SC_MONS 20 /* a level's monsters and long worms */
+#define SC_TRAP 21 /* a level's traps */
+#define SC_OBJS 22 /* a level's objects, buried objects and bill */
+#define SC_ENGR 23 /* a level's engravings */
+#define SC_DAMG 24 /* a level's shop damage */
+#define SC_REGN 25 /* a level's regions */
+#define NUM_SAVE_CHUNKS 26
+
+/*
+ * validate() turns a file away before anything is restored if one of its
+ * chunks has a tag we don't know or structures of a different size, or
+ * if a chunk is missing; rest_chunk() checks each tag as it is read, so
+ * data out of step is caught where it starts rather than further on.
+ */
+struct save_chunk {
+    char tag[5];
+    unsigned long size; /* total sizeof the raw structures it holds */
+};
+extern const struct save_chunk save_chunks[NUM_SAVE_CHUNKS];
+
 /* The following are used in mkmaze.c */
 struct container {
     struct container *next;
@@ -303,6 +303,7 @@ extern const struct symdef defsyms[MAXPCHARS]; /* defaults */
 extern const struct symdef def_warnsyms[WARNCOUNT];
 extern int currentgraphics; /* from drawing.c */
 extern nhsym showsyms[];
+extern unsigned showsyms_gen; /* from drawing.c */
 extern nhsym l_syms[];
 extern nhsym r_syms[];
 
@@ -587,11 +588,14 @@ typedef struct {
 #ifndef MICROPORT_BUG
     struct obj *objects[COLNO][ROWNO];
     struct monst *monsters[COLNO][ROWNO];
+    struct trap *traps[COLNO][ROWNO]; /* index into ftrap chain */
 #else
     struct obj *objects[1][ROWNO];
     char *yuk1[COLNO - 1][ROWNO];
     struct monst *monsters[1][ROWNO];
     char *yuk2[COLNO - 1][ROWNO];
+    struct trap *traps[1][ROWNO];
+    char *yuk3[COLNO - 1][ROWNO];
 #endif
     struct obj *objlist;
     struct obj *buriedobjlist;
@@ -636,6 +640,14 @@ extern dlevel_t level; /* structure describing the current level */
 #define m_buried_at(x, y) \
     (MON_BURIED_AT(x, y) ? level.monsters[x][y] : (struct monst *) 0)
 
+/*
+ * Macros for encapsulation of level.traps references; the ftrap chain
+ * remains the owner of the trap structures, level.traps[][] is only an
+ * index so that t_at() doesn't need to walk the chain.
+ */
+#define place_trap_at(t) level.traps[(t)->tx][(t)->ty] = (t)
+#define remove_trap_at(x, y) level.traps[x][y] = (struct trap *) 0
+
 /* restricted movement, potential luck penalties */
 #define Sokoban level.flags.sokoban_rules
 
@@ -28,6 +28,8 @@ struct sysopt {
     int check_save_uid; /* restoring savefile checks UID? */
     int check_plname; /* use plname for checking wizards/explorers/shellers */
     int bones_pools;
+    long levelstore; /* bytes of level files to keep in memory; 0: none */
+    int levelstore_ckpt; /* min. turns between writing them at checkpoint */
 
     /* record file */
     int persmax;
@@ -137,6 +137,14 @@
 #define TIMED_DELAY
 #endif
 
+/*
+ * Define LEVELIO_THREAD to have a background thread write out the level
+ * being left and read in the levels next to the new one, so that level
+ * changes don't wait for the disk.  Needs POSIX threads; compile and link
+ * with -pthread.
+ */
+/* #define LEVELIO_THREAD */ /* pthread_create() */
+
 /* #define AVOID_WIN_IOCTL */ /* ensure USE_WIN_IOCTL remains undefined */
 
 /*
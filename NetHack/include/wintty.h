@@ -16,6 +16,7 @@ typedef struct tty_mi {
     anything identifier; /* user identifier */
     long count;          /* user count */
     char *str;           /* description string (including accelerator) */
+    int width;           /* columns needed to show str */
     int attr;            /* string attribute */
     boolean selected;    /* TRUE if selected by user */
     char selector;       /* keyboard accelerator */
@@ -50,6 +51,9 @@ struct WinDesc {
 #define WIN_STOP 1        /* for NHW_MESSAGE; stops output */
 #define WIN_LOCKHISTORY 2 /* for NHW_MESSAGE; suppress history updates */
 
+/* most UTF-8 bytes one screen column can take; sizes the status rows */
+#define MAXCOLBYTES 3
+
 /* descriptor for tty-based displays -- all the per-display data */
 struct DisplayDesc {
     short rows, cols; /* width and height of tty display */
@@ -88,6 +92,14 @@ extern struct DisplayDesc *ttyDisplay; /* the tty display descriptor */
 
 extern char morc;         /* last character typed to xwaitforspace */
 extern char defmorestr[]; /* default --more-- prompt */
+extern long tty_obytes;   /* bytes sent to the terminal so far */
+
+/* all single-character terminal output goes through here so that it
+   gets counted for the per-frame output statistics */
+#define tty_putchar(c) (tty_obytes++, (void) putchar(c))
+
+/* cost reported for a cursor motion a terminal can't do directly */
+#define MOTION_NONE 10000
 
 /* port specific external function references */
 
@@ -99,6 +111,8 @@ E void FDECL(xwaitforspace, (const char *));
 E void FDECL(tty_startup, (int *, int *));
 #ifndef NO_TERMS
 E void NDECL(tty_shutdown);
+E int FDECL(nocmov_cost, (int, int, int, int));
+E int FDECL(cmov_cost, (int, int));
 #endif
 #if defined(apollo)
 /* Apollos don't widen old-style function definitions properly -- they try to
@@ -154,6 +168,8 @@ E void FDECL(addtopl, (const char *));
 E void NDECL(more);
 E void FDECL(update_topl, (const char *));
 E void FDECL(putsyms, (const char *));
+E void FDECL(init_msghistory, (int));
+E void NDECL(free_msghistory);
 
 /* ### wintty.c ### */
 #ifdef CLIPPING
@@ -162,6 +178,12 @@ E void NDECL(setclipped);
 E void FDECL(docorner, (int, int));
 E void NDECL(end_glyphout);
 E void FDECL(g_putch, (int));
+E void NDECL(tty_flush);
+E void FDECL(tty_output_stats, (const char *, char *, long *, long *));
+E int FDECL(tty_charlen, (const char *));
+E int FDECL(tty_charwidth, (const char *));
+E int FDECL(tty_strwidth, (const char *));
+E int FDECL(tty_strfit, (const char *, int));
 E void FDECL(win_tty_init, (int));
 
 /* external declarations */
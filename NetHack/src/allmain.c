@@ -114,6 +114,7 @@ boolean resuming;
                     /* reallocate movement rations to monsters */
                     for (mtmp = fmon; mtmp; mtmp = mtmp->nmon)
                         mtmp->movement += mcalcmove(mtmp);
+                    reset_mready();
 
                     if (!rn2(u.uevent.udemigod
                                  ? 25
@@ -529,6 +529,7 @@ make_bones:
         store_savefileinfo(fd);
         bwrite(fd, (genericptr_t) &c, sizeof c);
         bwrite(fd, (genericptr_t) bonesid, (unsigned) c); /* DD.nnn */
+        save_chunk(fd, COUNT_SAVE, SC_FRUT);
         savefruitchn(fd, COUNT_SAVE);
         bflush(fd);
         if (bytes_counted > freediskspace(bones)) { /* not enough room */
@@ -546,6 +547,7 @@ make_bones:
     store_savefileinfo(fd);
     bwrite(fd, (genericptr_t) &c, sizeof c);
     bwrite(fd, (genericptr_t) bonesid, (unsigned) c); /* DD.nnn */
+    save_chunk(fd, WRITE_SAVE, SC_FRUT);
     savefruitchn(fd, WRITE_SAVE | FREE_SAVE);
     update_mlstmv(); /* update monsters for eventual restoration */
     savelev(fd, ledger_no(&u.uz), WRITE_SAVE | FREE_SAVE);
@@ -585,6 +587,7 @@ getbones()
         if (wizard) {
             if (yn("Get bones?") == 'n') {
                 (void) nhclose(fd);
+                reset_restpref();
                 compress_bonesfile();
                 return 0;
             }
@@ -639,6 +642,9 @@ getbones()
         }
     }
     (void) nhclose(fd);
+    /* validate() adopted the bones file's settings; go back to ours
+       for the level files we write and read from here on */
+    reset_restpref();
     sanitize_engravings();
     u.uroleplay.numbones++;
 
@@ -427,6 +427,7 @@ struct istat_s {
     int valwidth;
     enum statusfields idxmax;
     enum statusfields fld;
+    long depkey; /* the state val was last formatted from */
 #ifdef STATUS_HILITES
     struct hilite_s *thresholds;
 #endif
@@ -442,7 +443,32 @@ STATIC_DCL boolean FDECL(evaluate_and_notify_windowport_field,
 STATIC_DCL void FDECL(evaluate_and_notify_windowport, (boolean *, int, int));
 
 #ifdef STATUS_HILITES
+/*
+ * A field's hilite rules, other than text matches, are precompiled into
+ * a table of the resulting color.  The rules compare the field's value
+ * and percentage against their thresholds, so the result can only change
+ * where one of those comparisons does; val[] and pc[] hold those points
+ * and split the value and percentage ranges into intervals.  color[] has
+ * an entry for each value interval, percentage interval and direction of
+ * change.
+ */
+struct hl_table {
+    unsigned gen;   /* hilite_gen when this was built */
+    boolean updown; /* has BL_TH_UPDOWN rules (which time out) */
+    int nval, npc;  /* number of breakpoints in val[] and pc[] */
+    int *val, *pc;  /* sorted breakpoints */
+    int *color;     /* null if the rules have to be walked instead */
+};
+
+#define HL_TABLE_MAX 3000 /* most color[] entries to precompute */
+
 STATIC_DCL boolean FDECL(hilite_reset_needed, (struct istat_s *, long));
+STATIC_DCL int FDECL(hilite_walk, (struct hilite_s *, int, int, int, int,
+                                   const char *));
+STATIC_DCL void FDECL(add_breakpoint, (int *, int *, int));
+STATIC_DCL int FDECL(hilite_interval, (int *, int, int));
+STATIC_DCL struct hl_table *FDECL(hilite_table, (int));
+STATIC_DCL void FDECL(free_hilite_table, (int));
 STATIC_DCL void FDECL(s_to_anything, (anything *, char *, int));
 STATIC_DCL boolean FDECL(is_ltgt_percentnumber, (const char *));
 STATIC_DCL boolean FDECL(has_ltgt_percentnumber, (const char *));
@@ -509,6 +535,10 @@ static boolean blinit = FALSE, update_all = FALSE;
 static boolean valset[MAXBLSTATS];
 unsigned long blcolormasks[CLR_MAX];
 static long bl_hilite_moves = 0L;
+#ifdef STATUS_HILITES
+static struct hl_table hltables[MAXBLSTATS];
+static unsigned hilite_gen = 1; /* bumped whenever any thresholds change */
+#endif
 
 /* we don't put this next declaration in #ifdef STATUS_HILITES.
  * In the absence of STATUS_HILITES, each array
@@ -525,7 +555,7 @@ bot_via_windowport()
     char buf[BUFSZ];
     register char *nb;
     static int i, idx = 0, idx_p, cap;
-    long money;
+    long money, key;
 
     if (!blinit)
         panic("bot before init.");
@@ -543,20 +573,29 @@ bot_via_windowport()
      */
 
     /*
-     *  Player name and title.
+     *  Player name and title.  Like the dungeon level below, this is
+     *  only formatted again when the state it is made from changes.
      */
-    Strcpy(nb = buf, plname);
-    nb[0] = highc(nb[0]);
-    if(strlen("中")==2) nb[10] = '\0';
-    else nb[15] = '\0';
-    Sprintf(nb = eos(nb), "  ");
-    if (Upolyd) {
-        for (i = 0, nb = strcpy(eos(nb), mons[u.umonnum].mname); nb[i]; i++)
-            if (i == 0 || nb[i - 1] == ' ')
-                nb[i] = highc(nb[i]);
-    } else
-        Strcpy(nb = eos(nb), rank());
-    Sprintf(blstats[idx][BL_TITLE].val, "%-29s", buf);
+    key = ((long) (Upolyd ? u.umonnum + 1 : 0) << 8)
+          | ((long) u.ulevel << 1) | (long) flags.female;
+    if (!update_all && key == blstats[idx_p][BL_TITLE].depkey) {
+        Strcpy(blstats[idx][BL_TITLE].val, blstats[idx_p][BL_TITLE].val);
+    } else {
+        Strcpy(nb = buf, plname);
+        nb[0] = highc(nb[0]);
+        if(strlen("中")==2) nb[10] = '\0';
+        else nb[15] = '\0';
+        Sprintf(nb = eos(nb), "  ");
+        if (Upolyd) {
+            for (i = 0, nb = strcpy(eos(nb), mons[u.umonnum].mname); nb[i];
+                 i++)
+                if (i == 0 || nb[i - 1] == ' ')
+                    nb[i] = highc(nb[i]);
+        } else
+            Strcpy(nb = eos(nb), rank());
+        Sprintf(blstats[idx][BL_TITLE].val, "%-29s", buf);
+    }
+    blstats[idx][BL_TITLE].depkey = key;
     valset[BL_TITLE] = TRUE; /* indicate val already set */
 
     /* Strength */
@@ -594,7 +633,13 @@ bot_via_windowport()
     blstats[idx][BL_HPMAX].a.a_int = min(i, 9999);
 
     /*  Dungeon level. */
-    (void) describe_level(blstats[idx][BL_LEVELDESC].val);
+    key = ((long) u.uz.dnum << 8) | (long) u.uz.dlevel;
+    if (!update_all && key == blstats[idx_p][BL_LEVELDESC].depkey)
+        Strcpy(blstats[idx][BL_LEVELDESC].val,
+               blstats[idx_p][BL_LEVELDESC].val);
+    else
+        (void) describe_level(blstats[idx][BL_LEVELDESC].val);
+    blstats[idx][BL_LEVELDESC].depkey = key;
     valset[BL_LEVELDESC] = TRUE; /* indicate val already set */
 
     /* Gold */
@@ -835,6 +880,35 @@ status_eval_next_unhilite()
         context.botl = TRUE;
 }
 
+/* #wizbench: time bot() with nothing changed and with one field changing */
+void
+bot_bench(win)
+winid win;
+{
+    char buf[BUFSZ];
+    int i, pass, passes = 20000, save_uen = u.uen;
+    long t[2];
+
+    for (i = 0; i < 2; i++) {
+        t[i] = cputime_ms();
+        for (pass = 0; pass < passes; pass++) {
+            if (i)
+                u.uen = save_uen + (pass & 1);
+            context.botl = TRUE;
+            bot();
+        }
+        t[i] = cputime_ms() - t[i];
+    }
+    u.uen = save_uen;
+    context.botl = TRUE;
+    bot();
+
+    Sprintf(buf, "bot: %d calls, unchanged %ld/s, Pw changing %ld/s", passes,
+            (long) passes * 1000L / max(t[0], 1L),
+            (long) passes * 1000L / max(t[1], 1L));
+    putstr(win, 0, buf);
+}
+
 void
 status_initialize(reassessment)
 boolean
@@ -882,6 +956,7 @@ status_finish()
         if (blstats[1][i].val)
             free((genericptr_t) blstats[1][i].val), blstats[1][i].val = 0;
 #ifdef STATUS_HILITES
+        free_hilite_table(i);
         if (blstats[0][i].thresholds) {
             struct hilite_s *temp = blstats[0][i].thresholds,
                             *next = (struct hilite_s *)0;
@@ -1260,8 +1335,6 @@ hilite_reset_needed(bl_p, augmented_time)
 struct istat_s *bl_p;
 long augmented_time;
 {
-    struct hilite_s *tl = bl_p->thresholds;
-
     /*
      * This 'multi' handling may need some tuning...
      */
@@ -1271,14 +1344,8 @@ long augmented_time;
     if (bl_p->time == 0 || bl_p->time >= augmented_time)
         return FALSE;
 
-    while (tl) {
-        /* only this style times out */
-        if (tl->behavior == BL_TH_UPDOWN)
-            return TRUE;
-        tl = tl->next;
-    }
-
-    return FALSE;
+    /* only BL_TH_UPDOWN style times out */
+    return (boolean) (bl_p->thresholds && hilite_table(bl_p->fld)->updown);
 }
 
 /* called by options handling when 'statushilites' boolean is toggled */
@@ -1347,95 +1414,223 @@ int idx, fldidx, chg, pc;
 genericptr_t vp;
 int *colorptr;
 {
-    int bestcolor = NO_COLOR;
-    struct hilite_s *hl;
     anything *value = (anything *)vp;
-    char *txtstr, *cmpstr;
+    struct hl_table *t;
 
     if (!colorptr || fldidx < 0 || fldidx >= MAXBLSTATS)
         return;
 
+    *colorptr = NO_COLOR;
     if (blstats[idx][fldidx].thresholds) {
         /* there are hilites set here */
-        int max_pc = 0, min_pc = 100;
-        int max_val = 0, min_val = LARGEST_INT;
-        boolean exactmatch = FALSE;
-
-        hl = blstats[idx][fldidx].thresholds;
+        t = hilite_table(fldidx);
+        if (t->color)
+            *colorptr = t->color[(hilite_interval(t->val, t->nval,
+                                                  value->a_int)
+                                  * (t->npc + 1)
+                                  + hilite_interval(t->pc, t->npc, pc)) * 3
+                                 + sgn(chg) + 1];
+        else
+            *colorptr = hilite_walk(blstats[idx][fldidx].thresholds, fldidx,
+                                    value->a_int, chg, pc,
+                                    blstats[idx][fldidx].val);
+    }
+    return;
+}
 
-        while (hl) {
-            switch (hl->behavior) {
-            case BL_TH_VAL_PERCENTAGE:
-                if (hl->rel == EQ_VALUE && pc == hl->value.a_int) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    min_pc = max_pc = hl->value.a_int;
-                    exactmatch = TRUE;
-                } else if (hl->rel == LT_VALUE && !exactmatch
-                           && (hl->value.a_int >= pc)
-                           && (hl->value.a_int <= min_pc)) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    min_pc = hl->value.a_int;
-                } else if (hl->rel == GT_VALUE && !exactmatch
-                           && (hl->value.a_int <= pc)
-                           && (hl->value.a_int >= max_pc)) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    max_pc = hl->value.a_int;
-                }
-                break;
-            case BL_TH_UPDOWN:
-                if (chg < 0 && hl->rel == LT_VALUE) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                } else if (chg > 0 && hl->rel == GT_VALUE) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                } else if (hl->rel == EQ_VALUE && chg) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    min_val = max_val = hl->value.a_int;
-                }
-                break;
-            case BL_TH_VAL_ABSOLUTE:
-                if (hl->rel == EQ_VALUE && hl->value.a_int == value->a_int) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    min_val = max_val = hl->value.a_int;
-                    exactmatch = TRUE;
-                } else if (hl->rel == LT_VALUE && !exactmatch
-                           && (hl->value.a_int >= value->a_int)
-                           && (hl->value.a_int < min_val)) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    min_val = hl->value.a_int;
-                } else if (hl->rel == GT_VALUE && !exactmatch
-                           && (hl->value.a_int <= value->a_int)
-                           && (hl->value.a_int > max_val)) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                    max_val = hl->value.a_int;
-                }
-                break;
-            case BL_TH_TEXTMATCH:
-                txtstr = dupstr(blstats[idx][fldidx].val);
-                cmpstr = txtstr;
-                if (fldidx == BL_TITLE) {
-                    int len = (strlen(plname) + sizeof(" the"));
-                    cmpstr += len;
-                }
-                (void) trimspaces(cmpstr);
-                if (hl->rel == TXT_VALUE && hl->textmatch[0] &&
-                    !strcmpi(hl->textmatch, cmpstr)) {
-                    merge_bestcolor(&bestcolor, hl->coloridx);
-                }
-                free(txtstr);
-                break;
-            case BL_TH_ALWAYS_HILITE:
+/* apply a field's hilite rules one by one; text is the field's value
+   as displayed, only needed for BL_TH_TEXTMATCH */
+STATIC_OVL int
+hilite_walk(hl, fldidx, val, chg, pc, text)
+struct hilite_s *hl;
+int fldidx, val, chg, pc;
+const char *text;
+{
+    int bestcolor = NO_COLOR;
+    char *txtstr, *cmpstr;
+    int max_pc = 0, min_pc = 100;
+    int max_val = 0, min_val = LARGEST_INT;
+    boolean exactmatch = FALSE;
+
+    while (hl) {
+        switch (hl->behavior) {
+        case BL_TH_VAL_PERCENTAGE:
+            if (hl->rel == EQ_VALUE && pc == hl->value.a_int) {
                 merge_bestcolor(&bestcolor, hl->coloridx);
+                min_pc = max_pc = hl->value.a_int;
+                exactmatch = TRUE;
+            } else if (hl->rel == LT_VALUE && !exactmatch
+                       && (hl->value.a_int >= pc)
+                       && (hl->value.a_int <= min_pc)) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+                min_pc = hl->value.a_int;
+            } else if (hl->rel == GT_VALUE && !exactmatch
+                       && (hl->value.a_int <= pc)
+                       && (hl->value.a_int >= max_pc)) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+                max_pc = hl->value.a_int;
+            }
+            break;
+        case BL_TH_UPDOWN:
+            if (chg < 0 && hl->rel == LT_VALUE) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+            } else if (chg > 0 && hl->rel == GT_VALUE) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+            } else if (hl->rel == EQ_VALUE && chg) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+                min_val = max_val = hl->value.a_int;
+            }
+            break;
+        case BL_TH_VAL_ABSOLUTE:
+            if (hl->rel == EQ_VALUE && hl->value.a_int == val) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+                min_val = max_val = hl->value.a_int;
+                exactmatch = TRUE;
+            } else if (hl->rel == LT_VALUE && !exactmatch
+                       && (hl->value.a_int >= val)
+                       && (hl->value.a_int < min_val)) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+                min_val = hl->value.a_int;
+            } else if (hl->rel == GT_VALUE && !exactmatch
+                       && (hl->value.a_int <= val)
+                       && (hl->value.a_int > max_val)) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+                max_val = hl->value.a_int;
+            }
+            break;
+        case BL_TH_TEXTMATCH:
+            if (!text)
                 break;
-            case BL_TH_NONE:
-                break;
-            default:
-                break;
+            txtstr = dupstr(text);
+            cmpstr = txtstr;
+            if (fldidx == BL_TITLE) {
+                int len = (strlen(plname) + sizeof(" the"));
+                cmpstr += len;
             }
-            hl = hl->next;
-	}
+            (void) trimspaces(cmpstr);
+            if (hl->rel == TXT_VALUE && hl->textmatch[0] &&
+                !strcmpi(hl->textmatch, cmpstr)) {
+                merge_bestcolor(&bestcolor, hl->coloridx);
+            }
+            free(txtstr);
+            break;
+        case BL_TH_ALWAYS_HILITE:
+            merge_bestcolor(&bestcolor, hl->coloridx);
+            break;
+        case BL_TH_NONE:
+            break;
+        default:
+            break;
+        }
+        hl = hl->next;
     }
-    *colorptr = bestcolor;
-    return;
+    return bestcolor;
+}
+
+/* insert v into the sorted breakpoint list b[] unless it's already there */
+STATIC_OVL void
+add_breakpoint(b, np, v)
+int *b, *np, v;
+{
+    int i;
+
+    for (i = *np; i > 0 && b[i - 1] > v; i--)
+        continue;
+    if (i > 0 && b[i - 1] == v)
+        return;
+    (void) memmove((genericptr_t) &b[i + 1], (genericptr_t) &b[i],
+                   (*np - i) * sizeof *b);
+    b[i] = v;
+    (*np)++;
+}
+
+/* which interval x falls in: the number of breakpoints at or below it */
+STATIC_OVL int
+hilite_interval(b, n, x)
+int *b, n, x;
+{
+    int lo = 0, hi = n, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (b[mid] <= x)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/* the precompiled form of fld's hilite rules, rebuilt if they changed */
+STATIC_OVL struct hl_table *
+hilite_table(fld)
+int fld;
+{
+    struct hl_table *t = &hltables[fld];
+    struct hilite_s *hl, *rules = blstats[0][fld].thresholds;
+    int n = 0, v, p, c, vx, px, *cp;
+    boolean textual = FALSE;
+
+    if (t->gen == hilite_gen)
+        return t;
+    free_hilite_table(fld);
+    t->gen = hilite_gen;
+
+    for (hl = rules; hl; hl = hl->next, n++) {
+        if (hl->behavior == BL_TH_UPDOWN)
+            t->updown = TRUE;
+        else if (hl->behavior == BL_TH_TEXTMATCH)
+            textual = TRUE;
+    }
+    if (textual || !n)
+        return t;
+
+    /* each threshold v is compared as ==v, <=v and >=v, so the outcome
+       can change going from v-1 to v and from v to v+1 */
+    t->val = (int *) alloc(2 * n * sizeof (int));
+    t->pc = (int *) alloc(2 * n * sizeof (int));
+    for (hl = rules; hl; hl = hl->next) {
+        if (hl->behavior == BL_TH_VAL_ABSOLUTE) {
+            add_breakpoint(t->val, &t->nval, hl->value.a_int);
+            add_breakpoint(t->val, &t->nval, hl->value.a_int + 1);
+        } else if (hl->behavior == BL_TH_VAL_PERCENTAGE) {
+            add_breakpoint(t->pc, &t->npc, hl->value.a_int);
+            add_breakpoint(t->pc, &t->npc, hl->value.a_int + 1);
+        }
+    }
+    if ((t->nval + 1) * (t->npc + 1) * 3 > HL_TABLE_MAX) {
+        free_hilite_table(fld);
+        t->gen = hilite_gen;
+        return t;
+    }
+
+    /* evaluate the rules once at a point within each interval */
+    cp = t->color = (int *) alloc((t->nval + 1) * (t->npc + 1) * 3
+                                  * sizeof (int));
+    for (v = 0; v <= t->nval; v++) {
+        vx = !v ? (t->nval ? t->val[0] - 1 : 0) : t->val[v - 1];
+        for (p = 0; p <= t->npc; p++) {
+            px = !p ? (t->npc ? t->pc[0] - 1 : 0) : t->pc[p - 1];
+            for (c = -1; c <= 1; c++)
+                *cp++ = hilite_walk(rules, fld, vx, c, px, (char *) 0);
+        }
+    }
+    return t;
+}
+
+STATIC_OVL void
+free_hilite_table(fld)
+int fld;
+{
+    struct hl_table *t = &hltables[fld];
+
+    if (t->val)
+        free((genericptr_t) t->val);
+    if (t->pc)
+        free((genericptr_t) t->pc);
+    if (t->color)
+        free((genericptr_t) t->color);
+    (void) memset((genericptr_t) t, 0, sizeof *t);
 }
 
 STATIC_OVL void
@@ -1664,6 +1859,7 @@ struct hilite_s *hilite;
     }
     /* current and prev must both point at the same hilites */
     blstats[1][fld].thresholds = blstats[0][fld].thresholds;
+    hilite_gen++;
 }
 
 
@@ -2208,6 +2404,7 @@ clear_status_hilites()
 {
     int i;
 
+    hilite_gen++;
     for (i = 0; i < MAXBLSTATS; ++i) {
         if (blstats[0][i].thresholds) {
             struct hilite_s *temp = blstats[0][i].thresholds,
@@ -3036,6 +3233,7 @@ int id;
                             blstats[0][fld].thresholds;
                     }
                     free(hl);
+                    hilite_gen++;
                     return TRUE;
                 }
                 hlprev = hl;
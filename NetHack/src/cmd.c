@@ -7,6 +7,10 @@
 #include "lev.h"
 #include "func_tab.h"
 
+#ifdef TTY_GRAPHICS
+#include "wintty.h" /* tty_output_stats() */
+#endif
+
 #ifdef ALTMETA
 STATIC_VAR boolean alt_esc = FALSE;
 #endif
@@ -161,6 +165,7 @@ STATIC_DCL void FDECL(mon_chain, (winid, const char *, struct monst *,
 STATIC_DCL void FDECL(contained_stats, (winid, const char *, long *, long *));
 STATIC_DCL void FDECL(misc_stats, (winid, long *, long *));
 STATIC_PTR int NDECL(wiz_show_stats);
+STATIC_PTR int NDECL(wiz_bench);
 STATIC_DCL boolean FDECL(accept_menu_prefix, (int NDECL((*))));
 #ifdef PORT_DEBUG
 STATIC_DCL int NDECL(wiz_port_debug);
@@ -3020,6 +3025,8 @@ struct ext_func_tab extcmdlist[] = {
             dowhatis, IFBURIED | GENERALCMD },
     { 'w', "wield", "持握", "装备武器", dowield },
     { M('w'), "wipe", "擦脸", "擦你的脸", dowipe, AUTOCOMPLETE },
+    { '\0', "wizbench", "wizbench", "time some internal routines",
+            wiz_bench, IFBURIED | AUTOCOMPLETE | WIZMODECMD },
 #ifdef DEBUG
     { '\0', "wizdebug_bury", "wizdebug_bury", "wizard debug: bury objs under and around you",
             wiz_debug_cmd_bury, IFBURIED | AUTOCOMPLETE | WIZMODECMD },
@@ -3527,6 +3534,34 @@ long *total_size;
         putstr(win, 0, buf);
     }
 
+    /* not included in the totals; the map is gone once loading is done */
+    count = size = 0L;
+    id_map_stats("ghost id map, %ld probes", hdrbuf, &count, &size);
+    if (count || size) {
+        Sprintf(buf, template, hdrbuf, count, size);
+        putstr(win, 0, buf);
+    }
+
+    /* not included in the totals either; count is partial recalcs */
+    count = size = 0L;
+    vision_stats("line of sight, %ld rows last turn", hdrbuf, &count,
+                 &size);
+    if (count || size) {
+        Sprintf(buf, template, hdrbuf, count, size);
+        putstr(win, 0, buf);
+    }
+
+#ifdef TTY_GRAPHICS
+    /* count is frames written to the terminal, size is total bytes */
+    if (!strcmp(windowprocs.name, "tty")) {
+        count = size = 0L;
+        tty_output_stats("tty output, last %ld max %ld", hdrbuf, &count,
+                         &size);
+        Sprintf(buf, template, hdrbuf, count, size);
+        putstr(win, 0, buf);
+    }
+#endif
+
     count = size = 0L;
     for (sd = level.damagelist; sd; sd = sd->next) {
         ++count;
@@ -3665,6 +3700,28 @@ wiz_show_stats()
     return 0;
 }
 
+/*
+ * #wizbench command - time some of the routines that have a faster
+ * path against their plain versions.  Times are processor time.
+ */
+static int
+wiz_bench(VOID_ARGS)
+{
+    winid win;
+
+    win = create_nhwindow(NHW_TEXT);
+    putstr(win, 0, "Timings:");
+    putstr(win, 0, "");
+    mapglyph_bench(win);
+    bot_bench(win);
+    rnd_bench(win);
+    timer_bench(win);
+    mfndpos_bench(win);
+    display_nhwindow(win, FALSE);
+    destroy_nhwindow(win);
+    return 0;
+}
+
 void
 sanity_check()
 {
@@ -3672,6 +3729,7 @@ sanity_check()
     timer_sanity_check();
     mon_sanity_check();
     light_sources_sanity_check();
+    trap_sanity_check();
 }
 
 #ifdef DEBUG_MIGRATING_MONS
@@ -4033,6 +4091,8 @@ int NDECL((*cmd_func));
         || cmd_func == dotravel
         /* wizard mode ^V */
         || cmd_func == wiz_level_tele
+        /* ^P: search message history, for window ports which can */
+        || cmd_func == doprev_message
         /* 'm' prefix allowed for some extended commands */
         || cmd_func == doextcmd || cmd_func == doextlist)
         return TRUE;
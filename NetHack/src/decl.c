@@ -297,16 +297,22 @@ NEARDATA struct savefile_info sfcap = {
 #endif
 #if defined(RLECOMP)
         | SFI1_RLECOMP
+#endif
+#if defined(LZCOMP)
+        | SFI1_LZCOMP | SFI1_LZVERSION(LZCOMP_VERSION)
 #endif
     ,
 #ifdef NHSTDC
-    0x00000000UL, 0x00000000UL
+    0x00000000UL | SFI2_SAVEINFO | SFI2_RNGSTATE | SFI2_CHUNKS, 0x00000000UL
 #else
-    0x00000000L, 0x00000000L
+    0x00000000L | SFI2_SAVEINFO | SFI2_RNGSTATE | SFI2_CHUNKS, 0x00000000L
 #endif
 };
 
-NEARDATA struct savefile_info sfrestinfo, sfsaveinfo = {
+/* level files we write ourselves are read back with our own chunks */
+NEARDATA struct savefile_info sfrestinfo = { 0L, SFI2_CHUNKS, 0L };
+
+NEARDATA struct savefile_info sfsaveinfo = {
 #ifdef NHSTDC
     0x00000000UL
 #else
@@ -323,9 +329,9 @@ NEARDATA struct savefile_info sfrestinfo, sfsaveinfo = {
 #endif
     ,
 #ifdef NHSTDC
-    0x00000000UL, 0x00000000UL
+    0x00000000UL | SFI2_SAVEINFO | SFI2_RNGSTATE | SFI2_CHUNKS, 0x00000000UL
 #else
-    0x00000000L, 0x00000000L
+    0x00000000L | SFI2_SAVEINFO | SFI2_RNGSTATE | SFI2_CHUNKS, 0x00000000L
 #endif
 };
 
@@ -369,7 +369,7 @@ register struct obj *sobj;
     }
     /* only under me - no separate display required */
     if (stale)
-        docrt();
+        refresh_map();
     You("注意到一些金币在你的%s之间.", makeplural(body_part(FOOT)));
     return 0;
 
@@ -434,7 +434,7 @@ outgoldmap:
     browse_map(ter_typ, "金币");
 
     reconstrain_map();
-    docrt();
+    refresh_map();
     if (Underwater)
         under_water(2);
     if (u.uburied)
@@ -481,7 +481,7 @@ register struct obj *sobj;
     if (!ct && !ctu) {
         known = stale && !confused;
         if (stale) {
-            docrt();
+            refresh_map();
             You("感觉到附近%s的缺乏.", what);
             if (sobj && sobj->blessed) {
                 if (!u.uedibility)
@@ -556,7 +556,7 @@ register struct obj *sobj;
         browse_map(ter_typ, "食物");
 
         reconstrain_map();
-        docrt();
+        refresh_map();
         if (Underwater)
             under_water(2);
         if (u.uburied)
@@ -758,7 +758,7 @@ int class;            /* an object class, 0 for all */
         browse_map(ter_typ, "物品");
 
     reconstrain_map();
-    docrt(); /* this will correctly reset vision */
+    refresh_map(); /* this will correctly reset vision */
     if (Underwater)
         under_water(2);
     if (u.uburied)
@@ -836,7 +836,8 @@ int mclass;                /* monster class, 0 for all */
         }
 
         reconstrain_map();
-        docrt(); /* redraw the screen to remove unseen monsters from map */
+        /* redraw the screen to remove unseen monsters from map */
+        refresh_map();
         if (Underwater)
             under_water(2);
         if (u.uburied)
@@ -1023,7 +1024,8 @@ outtrapmap:
     browse_map(ter_typ, "感兴趣的陷阱");
 
     reconstrain_map();
-    docrt(); /* redraw the screen to remove unseen traps from the map */
+    /* redraw the screen to remove unseen traps from the map */
+    refresh_map();
     if (Underwater)
         under_water(2);
     if (u.uburied)
@@ -1287,7 +1289,7 @@ do_mapping()
         /* browse_map() instead of display_nhwindow(WIN_MAP, TRUE) */
         browse_map(TER_DETECT | TER_MAP | TER_TRP | TER_OBJ,
                    "任何感兴趣的东西");
-        docrt();
+        refresh_map();
     }
     reconstrain_map();
     exercise(A_WIS, TRUE);
@@ -1339,7 +1341,7 @@ struct obj *sobj; /* scroll--actually fake spellbook--object */
     }
     reconstrain_map();
     if (refresh)
-        docrt();
+        refresh_map();
 }
 
 /* convert a secret door into a normal door */
@@ -1530,7 +1532,7 @@ struct trap *trap;
 
     if (cleared) {
         display_nhwindow(WIN_MAP, TRUE); /* wait */
-        docrt();
+        refresh_map();
     }
 }
 
@@ -1873,7 +1875,7 @@ int which_subset; /* when not full, whether to suppress objs and/or traps */
         unsigned swallowed = u.uswallow; /* before unconstrain_map() */
 
         if (unconstrain_map())
-            docrt();
+            refresh_map();
         default_glyph = cmap_to_glyph(level.flags.arboreal ? S_tree : S_stone);
 
         for (x = 1; x < COLNO; x++)
@@ -1909,7 +1911,7 @@ int which_subset; /* when not full, whether to suppress objs and/or traps */
         browse_map(which_subset, "任何感兴趣的东西");
 
         reconstrain_map();
-        docrt(); /* redraw the screen, restoring regular map */
+        refresh_map(); /* redraw the screen, restoring regular map */
         if (Underwater)
             under_water(2);
         if (u.uburied)
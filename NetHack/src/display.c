@@ -124,6 +124,7 @@ STATIC_DCL void FDECL(display_warning, (struct monst *));
 
 STATIC_DCL int FDECL(check_pos, (int, int, int));
 STATIC_DCL int FDECL(get_bk_glyph, (XCHAR_P, XCHAR_P));
+STATIC_DCL void FDECL(redraw_map, (BOOLEAN_P));
 
 /*#define WA_VERBOSE*/ /* give (x,y) locations for all "bad" spots */
 #ifdef WA_VERBOSE
@@ -1286,6 +1287,18 @@ doredraw()
 
 void
 docrt()
+{
+    redraw_map(TRUE);
+}
+
+/*
+ * Rebuild the map display from the hero's memory, vision and monsters.
+ * If clearit is set the screen is wiped first and everything is sent
+ * again; otherwise show_glyph() only marks the locations that differ.
+ */
+STATIC_OVL void
+redraw_map(clearit)
+boolean clearit;
 {
     register int x, y;
     register struct rm *lev;
@@ -1309,18 +1322,20 @@ docrt()
     /* shut down vision */
     vision_recalc(2);
 
-    /*
-     * This routine assumes that cls() does the following:
-     *      + fills the physical screen with the symbol for rock
-     *      + clears the glyph buffer
-     */
-    cls();
+    if (clearit) {
+        /*
+         * This routine assumes that cls() does the following:
+         *      + fills the physical screen with the symbol for rock
+         *      + clears the glyph buffer
+         */
+        cls();
+    }
 
     /* display memory */
     for (x = 1; x < COLNO; x++) {
         lev = &levl[x][0];
         for (y = 0; y < ROWNO; y++, lev++)
-            if (lev->glyph != cmap_to_glyph(S_stone))
+            if (!clearit || lev->glyph != cmap_to_glyph(S_stone))
                 show_glyph(x, y, lev->glyph);
     }
 
@@ -1330,7 +1345,8 @@ docrt()
     /* overlay with monsters */
     see_monsters();
 
-    context.botlx = 1; /* force a redraw of the bottom line */
+    if (clearit)
+        context.botlx = 1; /* force a redraw of the bottom line */
 }
 
 /* =========================================================================
@@ -1508,6 +1524,49 @@ cls()
     in_cls = FALSE;
 }
 
+/*
+ * Bring the map up to date after a change of level or of what the hero
+ * can sense, without wiping the screen.  The window is assumed to still
+ * show the glyph buffer, so only locations whose glyph ends up different
+ * from what is displayed there are sent on the next flush_screen().
+ * Use docrt() instead when the screen itself may have been disturbed.
+ */
+void
+refresh_map()
+{
+    static int shown[ROWNO][COLNO];
+    register int x, y;
+    register gbuf_entry *gptr;
+
+    if (!u.ux)
+        return;
+    if (u.uswallow || (Underwater && !Is_waterlevel(&u.uz)) || u.uburied
+        || iflags.use_background_glyph) {
+        docrt(); /* these clear the screen anyway */
+        return;
+    }
+
+    /* what is on the screen; -1 for locations already awaiting output */
+    for (y = 0; y < ROWNO; y++) {
+        gptr = &gbuf[y][0];
+        for (x = 0; x < COLNO; x++, gptr++)
+            shown[y][x] = gptr->new ? -1 : gptr->glyph;
+    }
+
+    redraw_map(FALSE);
+
+    /* a location can change more than once on the way, e.g. from a
+       monster to remembered floor and back to the same monster */
+    for (y = 0; y < ROWNO; y++) {
+        gptr = &gbuf[y][x = gbuf_start[y]];
+        for (; x <= gbuf_stop[y]; gptr++, x++)
+            if (gptr->new && gptr->glyph == shown[y][x]
+                /* piles aren't told apart from single objects here */
+                && !(iflags.hilite_pile && glyph_is_object(gptr->glyph)))
+                gptr->new = 0;
+    }
+}
+
 /*
  * Synch the third screen with the display.
  */
@@ -1543,13 +1602,15 @@ int cursor_on_u;
             }
     }
 
+    /* status goes out before the map window is displayed so that the
+       whole update reaches the terminal together */
+    if (context.botl || context.botlx)
+        bot();
     if (cursor_on_u)
         curs(WIN_MAP, u.ux, u.uy); /* move cursor to the hero */
     display_nhwindow(WIN_MAP, FALSE);
     reset_glyph_bbox();
     flushing = 0;
-    if (context.botl || context.botlx)
-        bot();
 }
 
 /* =========================================================================
@@ -20,6 +20,9 @@ STATIC_DCL void NDECL(final_level);
 /* static boolean FDECL(badspot, (XCHAR_P,XCHAR_P)); */
 
 extern int n_dgns; /* number of dungeons, from dungeon.c */
+#ifdef USE_TILES
+extern short glyph2tile[]; /* from tile.c */
+#endif
 
 static NEARDATA const char drop_types[] = { ALLOW_COUNT, COIN_CLASS,
                                             ALL_CLASSES, 0 };
@@ -100,7 +103,7 @@ boolean pushing;
 
             if (fills_up && u.uinwater && distu(rx, ry) == 0) {
                 u.uinwater = 0;
-                docrt();
+                refresh_map();
                 vision_full_recalc = 1;
                 You("发现自己再次在旱地上了!");
             } else if (lava && distu(rx, ry) <= 2) {
@@ -1104,6 +1107,7 @@ save_currentstate()
         bufon(fd);
         savelev(fd, ledger_no(&u.uz), WRITE_SAVE);
         bclose(fd);
+        levelstore_checkpoint(FALSE); /* levels kept in memory too */
     }
 
     /* write out non-level state */
@@ -1135,7 +1139,12 @@ boolean at_stairs, falling, portal;
             newdungeon = (u.uz.dnum != newlevel->dnum),
             was_in_W_tower = In_W_tower(u.ux, u.uy, &u.uz),
             familiar = FALSE,
-            new = FALSE; /* made a new level? */
+            new = FALSE, /* made a new level? */
+            newsyms = FALSE; /* switched symset or substituted tiles? */
+    int oldgraphics = currentgraphics;
+#ifdef USE_TILES
+    short oldtiles[MAXPCHARS];
+#endif
     struct monst *mtmp;
     char whynot[BUFSZ];
     char *annotation;
@@ -1259,10 +1268,19 @@ boolean at_stairs, falling, portal;
             remdun_mapseen(l_idx);
     }
 
-    if (Is_rogue_level(newlevel) || Is_rogue_level(&u.uz))
+    if (Is_rogue_level(newlevel) || Is_rogue_level(&u.uz)) {
         assign_graphics(Is_rogue_level(newlevel) ? ROGUESET : PRIMARY);
+        newsyms = TRUE;
+    }
 #ifdef USE_TILES
+    /* mines, Gehennom, Fort Ludios and Sokoban walls have their own
+       tiles; the glyphs stay the same, so the map diff can't see it */
+    (void) memcpy((genericptr_t) oldtiles,
+                  (genericptr_t) &glyph2tile[GLYPH_CMAP_OFF], sizeof oldtiles);
     substitute_tiles(newlevel);
+    if (memcmp((genericptr_t) oldtiles,
+               (genericptr_t) &glyph2tile[GLYPH_CMAP_OFF], sizeof oldtiles))
+        newsyms = TRUE;
 #endif
     check_gold_symbol();
     /* record this level transition as a potential seen branch unless using
@@ -1304,8 +1322,10 @@ boolean at_stairs, falling, portal;
             /* we'll reach here if running in wizard mode */
             error("Cannot continue this game.");
         }
+        attach_levelfile(new_ledger, fd); /* decode from memory */
         minit(); /* ZEROCOMP */
         getlev(fd, hackpid, new_ledger, FALSE);
+        detach_levelfile();
         (void) nhclose(fd);
         oinit(); /* reassign level dependent obj probabilities */
     }
@@ -1444,7 +1464,13 @@ boolean at_stairs, falling, portal;
 
     /* Reset the screen. */
     vision_reset(); /* reset the blockages */
-    docrt();        /* does a full vision recalc */
+    /* a symset change or tile substitution alters what glyphs look like
+       in ways the glyph buffer can't see, so redraw from scratch;
+       otherwise only send what differs */
+    if (newsyms || currentgraphics != oldgraphics)
+        docrt();        /* does a full vision recalc */
+    else
+        refresh_map();  /* ditto */
     flush_screen(-1);
 
     /*
@@ -1546,6 +1572,7 @@ boolean at_stairs, falling, portal;
 #ifdef INSURANCE
     save_currentstate();
 #endif
+    levelio_prefetch(); /* start reading the levels next to this one */
 
     if ((annotation = get_annotation(&u.uz)) != 0)
         You("记得这层是%s.", annotation);
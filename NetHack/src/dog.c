@@ -299,6 +299,7 @@ boolean with_you;
 
     mtmp->nmon = fmon;
     fmon = mtmp;
+    mid_index_add(mtmp, FM_FMON);
     if (mtmp->isshk)
         set_residency(mtmp, FALSE);
 
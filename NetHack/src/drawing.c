@@ -22,6 +22,7 @@ struct symsetentry symset[NUM_GRAPHICS];
 int currentgraphics = 0;
 
 nhsym showsyms[SYM_MAX] = DUMMY; /* symbols to be displayed */
+unsigned showsyms_gen = 0;       /* bumped whenever showsyms[] changes */
 nhsym l_syms[SYM_MAX] = DUMMY;   /* loaded symbols          */
 nhsym r_syms[SYM_MAX] = DUMMY;   /* rogue symbols           */
 
@@ -353,6 +354,7 @@ void
 update_bouldersym()
 {
     showsyms[SYM_BOULDER + SYM_OFF_X] = iflags.bouldersym;
+    showsyms_gen++;
     l_syms[SYM_BOULDER + SYM_OFF_X] = iflags.bouldersym;
     r_syms[SYM_BOULDER + SYM_OFF_X] = iflags.bouldersym;
 }
@@ -378,6 +380,7 @@ init_showsyms()
         else if (i == SYM_INVISIBLE)
             showsyms[i + SYM_OFF_X] = DEF_INVISIBLE;
     }
+    showsyms_gen++;
 }
 
 /* initialize defaults for the loadable symset */
@@ -473,6 +476,7 @@ int whichset;
         currentgraphics = PRIMARY;
         break;
     }
+    showsyms_gen++;
 }
 
 void
@@ -484,6 +488,7 @@ int nondefault;
     if (nondefault) {
         for (i = 0; i < SYM_MAX; i++)
             showsyms[i] = l_syms[i];
+        showsyms_gen++;
 #ifdef PC9800
         if (SYMHANDLING(H_IBM) && ibmgraphics_mode_callback)
             (*ibmgraphics_mode_callback)();
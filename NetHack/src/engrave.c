@@ -8,6 +8,17 @@
 
 STATIC_VAR NEARDATA struct engr *head_engr;
 
+/* position index for the head_engr chain; there is never more than one
+   engraving at a given spot.  `elbereth' caches the strict match used
+   by onscary() so that monster movement doesn't redo the comparison */
+STATIC_VAR NEARDATA struct engr_index {
+    struct engr *ep;
+    boolean elbereth;
+} engr_map[COLNO][ROWNO];
+
+STATIC_DCL void FDECL(index_engr, (struct engr *));
+STATIC_DCL void FDECL(unindex_engr, (struct engr *));
+
 /* degrade a utf-8 char in a string */
 void
 wipeout_utf8_char(str, ch, rep)
@@ -297,14 +308,33 @@ struct engr *
 engr_at(x, y)
 xchar x, y;
 {
-    register struct engr *ep = head_engr;
+    if (!isok(x, y))
+        return (struct engr *) 0;
+    return engr_map[x][y].ep;
+}
+
+/* (re)enter an engraving into engr_map[][]; also used after its text
+   has been altered so that the cached Elbereth bit stays accurate */
+STATIC_OVL void
+index_engr(ep)
+struct engr *ep;
+{
+    struct engr_index *ei = &engr_map[ep->engr_x][ep->engr_y];
+
+    ei->ep = ep;
+    ei->elbereth = fuzzymatch(ep->engr_txt, "Elbereth", "", TRUE);
+}
+
+STATIC_OVL void
+unindex_engr(ep)
+struct engr *ep;
+{
+    struct engr_index *ei = &engr_map[ep->engr_x][ep->engr_y];
 
-    while (ep) {
-        if (x == ep->engr_x && y == ep->engr_y)
-            return ep;
-        ep = ep->nxt_engr;
+    if (ei->ep == ep) {
+        ei->ep = (struct engr *) 0;
+        ei->elbereth = FALSE;
     }
-    return (struct engr *) 0;
 }
 
 /* Decide whether a particular string is engraved at a specified
@@ -330,6 +360,19 @@ boolean strict;
     return FALSE;
 }
 
+/* sengr_at("Elbereth", x, y, TRUE) without re-examining the text */
+boolean
+engr_elbereth_at(x, y)
+xchar x, y;
+{
+    struct engr *ep;
+
+    if (!isok(x, y) || !engr_map[x][y].elbereth)
+        return FALSE;
+    ep = engr_map[x][y].ep;
+    return (boolean) (ep->engr_type != HEADSTONE && ep->engr_time <= moves);
+}
+
 void
 u_wipe_engr(cnt)
 int cnt;
@@ -357,6 +400,8 @@ xchar x, y, cnt, magical;
                 ep->engr_txt++;
             if (!ep->engr_txt[0])
                 del_engr(ep);
+            else
+                index_engr(ep);
         }
     }
 }
@@ -458,6 +503,7 @@ xchar e_type;
     ep->engr_time = e_time;
     ep->engr_type = e_type > 0 ? e_type : rnd(N_ENGRAVE - 1);
     ep->engr_lth = smem;
+    index_engr(ep);
 }
 
 /* delete any engraving at location <x,y> */
@@ -1212,6 +1258,7 @@ sanitize_engravings()
 
     for (ep = head_engr; ep; ep = ep->nxt_engr) {
         sanitize_name(ep->engr_txt);
+        index_engr(ep);
     }
 }
 
@@ -1228,8 +1275,10 @@ int fd, mode;
             bwrite(fd, (genericptr_t) &ep->engr_lth, sizeof ep->engr_lth);
             bwrite(fd, (genericptr_t) ep, sizeof (struct engr) + ep->engr_lth);
         }
-        if (release_data(mode))
+        if (release_data(mode)) {
+            unindex_engr(ep);
             dealloc_engr(ep);
+        }
     }
     if (perform_bwrite(mode))
         bwrite(fd, (genericptr_t) &no_more_engr, sizeof no_more_engr);
@@ -1245,6 +1294,7 @@ int fd;
     unsigned lth;
 
     head_engr = 0;
+    (void) memset((genericptr_t) engr_map, 0, sizeof engr_map);
     while (1) {
         mread(fd, (genericptr_t) &lth, sizeof lth);
         if (lth == 0)
@@ -1259,6 +1309,7 @@ int fd;
          * to be able to move again.
          */
         ep->engr_time = moves;
+        index_engr(ep);
     }
 }
 
@@ -1298,6 +1349,7 @@ register struct engr *ep;
             return;
         }
     }
+    unindex_engr(ep);
     dealloc_engr(ep);
 }
 
@@ -1315,8 +1367,10 @@ struct engr *ep;
         ty = rn2(ROWNO);
     } while (engr_at(tx, ty) || !goodpos(tx, ty, (struct monst *) 0, 0));
 
+    unindex_engr(ep);
     ep->engr_x = tx;
     ep->engr_y = ty;
+    index_engr(ep);
 }
 
 /* Create a headstone at the given location.
@@ -43,6 +43,7 @@ const
 
 #if defined(UNIX) && defined(QT_GRAPHICS)
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <dirent.h>
 #include <stdlib.h>
 #endif
@@ -176,6 +177,43 @@ extern int n_dgns; /* from dungeon.c */
 #ifdef SELECTSAVED
 STATIC_PTR int FDECL(CFDECLSPEC strcmp_wrap, (const void *, const void *));
 #endif
+/* index of save files, so that listing them doesn't need to open each */
+#if defined(SELECTSAVED) && (defined(UNIX) || defined(WIN32))
+#define SAVEINDEX "saveindex"
+#define SAVEINDEX_FIELDS 10
+#endif
+#ifdef SAVEINDEX
+STATIC_DCL void FDECL(saveindex_collect, (char *));
+STATIC_DCL void FDECL(saveindex_owner, (char *));
+STATIC_DCL long FDECL(savefile_mtime, (const char *));
+STATIC_DCL int FDECL(saveindex_split, (char *, char **));
+STATIC_DCL char *FDECL(saveindex_entry, (const char *,
+                                         struct save_summary *));
+STATIC_DCL void FDECL(rewrite_saveindex, (const char *, const char *,
+                                          char **, int));
+STATIC_DCL boolean FDECL(read_saveindex, (char ***, int *));
+
+/*
+ * The save index holds one line per save file, with tab-separated
+ * fields: file, owner, name, role, race, gender, alignment, depth, turn
+ * and mtime.  "owner" is the part of the save file name that identifies
+ * the player's account.  A line with an empty file field marks an owner
+ * whose save files have all been indexed.  Entries are added by dosave0()
+ * and dropped by delete_savefile().  Anything else that changes the save
+ * directory makes it newer than the index, and then the next listing
+ * rescans it.
+ */
+static boolean idx_rebuild = FALSE; /* plname_from_file() collects entries */
+static char **idx_scan = 0;
+static int idx_nscan = 0, idx_scanmax = 0;
+#endif
+STATIC_DCL struct levstore *FDECL(levstore_find, (int));
+STATIC_DCL void FDECL(levstore_free, (int));
+STATIC_DCL boolean FDECL(levstore_spill, (struct levstore *));
+STATIC_DCL void NDECL(levstore_trim);
+STATIC_DCL void NDECL(levstore_close);
+STATIC_DCL int FDECL(create_levelfile_disk, (int, char *));
+STATIC_DCL char *FDECL(slurp_levelfile, (int, unsigned *));
 STATIC_DCL char *FDECL(set_bonesfile_name, (char *, d_level *));
 STATIC_DCL char *NDECL(set_bonestemp_name);
 #ifdef COMPRESS
@@ -484,10 +522,498 @@ int lev;
     return;
 }
 
+/*
+ * Level store:  when sysconf's LEVELSTORE is set, level files other than
+ * the lock file are kept in memory, up to that many bytes in total, and
+ * handed out as the pseudo descriptor LEVSTORE_FD.  Writes to it are
+ * collected by bwrite_image() and reads served by mread_image(); the
+ * image is filed away or released when that descriptor is nhclose()d.
+ * Once over budget, the least recently used levels are written out as
+ * ordinary level files, and levelstore_checkpoint() writes every level
+ * which isn't on disk yet so that recover can find them after a crash.
+ *
+ * With LEVELIO_THREAD, every level file goes through the store, whatever
+ * its budget, and a background thread does the file system work (see
+ * below); then the store also keeps the levels next to the hero's.
+ */
+#define LEVSTORE_FD 0x7ff0 /* never a real descriptor */
+
+static struct levstore {
+    struct levstore *next;
+    int lev;         /* ledger number */
+    unsigned len;    /* bytes in data[] */
+    char *data;
+    long used;       /* for least-recently-used replacement */
+    boolean dirty;   /* newer than the level file on disk (if any) */
+    boolean writing; /* the I/O thread is writing data[] out */
+    boolean nearby;  /* next to the hero's level; kept over budget */
+} *levstore = 0;
+static long levstore_bytes = 0L, levstore_clock = 0L;
+static int levstore_writing = -1, levstore_reading = -1;
+
+#ifdef LEVELIO_THREAD
+/*
+ * Level file I/O thread:  a departing level is collected in memory and
+ * queued to be written out, and once the hero has arrived the files of
+ * already visited levels above, below and across the branch stairs are
+ * queued to be read into the level store, so that goto_level() doesn't
+ * wait for the file system either way.  The lock file's checkpoint is
+ * queued the same way; jobs are done in order, so it never reaches the
+ * disk ahead of the levels it refers to.  Whatever opens, rewrites or
+ * deletes a level file first waits for that level's jobs, and
+ * clearlocks() and levelstore_checkpoint(TRUE) wait for all of them, so
+ * savelev() and delete_levelfile() mean what they did.  The thread only
+ * uses open(), read(), write(), close() and malloc(), never game state.
+ */
+#include <pthread.h>
+
+#define LIO_QUEUED 0
+#define LIO_BUSY 1
+#define LIO_DONE 2
+
+static struct levio {
+    struct levio *next;
+    int lev;         /* ledger number */
+    int state;       /* LIO_xxx */
+    boolean reading; /* read the file into data[]; else write it out */
+    boolean owned;   /* data[] belongs to the job rather than the store */
+    int err;         /* errno of a failure, or 0 */
+    char *path;      /* fully qualified level file name */
+    char *data;
+    unsigned len;
+} *levio_jobs = 0;
+static pthread_mutex_t levio_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t levio_work = PTHREAD_COND_INITIALIZER,
+                      levio_done = PTHREAD_COND_INITIALIZER;
+static int levio_thread = 0; /* 1: running, -1: couldn't be started */
+
+STATIC_DCL genericptr_t FDECL(levio_main, (genericptr_t));
+STATIC_DCL void FDECL(levio_do, (struct levio *));
+STATIC_DCL boolean NDECL(levio_start);
+STATIC_DCL void FDECL(levio_queue, (int, BOOLEAN_P, char *, unsigned));
+STATIC_DCL void FDECL(levio_wait, (int, BOOLEAN_P));
+STATIC_DCL void NDECL(levio_collect);
+#else
+#define levio_start() FALSE
+#define levio_wait(lev, cancel) ((void) 0)
+#define levio_collect() ((void) 0)
+#endif
+#define levio_sync() levio_wait(-1, FALSE)
+
+STATIC_OVL struct levstore *
+levstore_find(lev)
+int lev;
+{
+    struct levstore *ls;
+
+    for (ls = levstore; ls; ls = ls->next)
+        if (ls->lev == lev)
+            return ls;
+    return (struct levstore *) 0;
+}
+
+STATIC_OVL void
+levstore_free(lev)
+int lev;
+{
+    struct levstore *ls, **prev;
+
+    if ((ls = levstore_find(lev)) != 0 && ls->writing)
+        levio_wait(lev, FALSE); /* don't pull data[] from under a write */
+    for (prev = &levstore; (ls = *prev) != 0; prev = &ls->next)
+        if (ls->lev == lev) {
+            *prev = ls->next;
+            levstore_bytes -= (long) ls->len;
+            free((genericptr_t) ls->data);
+            free((genericptr_t) ls);
+            return;
+        }
+}
+
+/* write a stored level out as an ordinary level file */
+STATIC_OVL boolean
+levstore_spill(ls)
+struct levstore *ls;
+{
+    char whynot[BUFSZ];
+    int fd = create_levelfile_disk(ls->lev, whynot);
+
+    if (fd < 0) {
+        impossible("%s", whynot);
+        return FALSE;
+    }
+    if ((unsigned) write(fd, (genericptr_t) ls->data, ls->len) != ls->len) {
+        impossible("Cannot write level %d (errno %d).", ls->lev, errno);
+        (void) nhclose(fd);
+        return FALSE;
+    }
+    (void) nhclose(fd);
+    ls->dirty = FALSE;
+    return TRUE;
+}
+
+/* keep the store within its budget by moving levels to disk */
+STATIC_OVL void
+levstore_trim()
+{
+    struct levstore *ls, *oldest;
+
+    while (levstore_bytes > sysopt.levelstore) {
+        oldest = 0;
+        for (ls = levstore; ls; ls = ls->next)
+            if (ls->lev != levstore_reading && !ls->writing && !ls->nearby
+                && (!oldest || ls->used < oldest->used))
+                oldest = ls;
+        if (!oldest || (oldest->dirty && !levstore_spill(oldest)))
+            break;
+        levstore_free(oldest->lev);
+    }
+}
+
+/* nhclose() of LEVSTORE_FD */
+STATIC_OVL void
+levstore_close()
+{
+    struct levstore *ls;
+
+    if (levstore_writing > 0) {
+        levstore_free(levstore_writing);
+        ls = (struct levstore *) alloc(sizeof *ls);
+        ls->lev = levstore_writing;
+        ls->data = bwrite_image_done(&ls->len);
+        ls->used = ++levstore_clock;
+        ls->dirty = TRUE;
+        ls->writing = ls->nearby = FALSE;
+        ls->next = levstore;
+        levstore = ls;
+        levstore_bytes += (long) ls->len;
+        levstore_writing = -1;
+#ifdef LEVELIO_THREAD
+        if (levio_start()) {
+            ls->writing = TRUE;
+            levio_queue(ls->lev, FALSE, ls->data, ls->len);
+        }
+#endif
+        levstore_trim();
+#ifdef LEVELIO_THREAD
+    } else if (levstore_writing == 0) {
+        unsigned len;
+        char *data = bwrite_image_done(&len);
+
+        /* the lock file is only ever written out, never stored */
+        levio_queue(0, TRUE, data, len);
+        levstore_writing = -1;
+#endif
+    } else if (levstore_reading >= 0) {
+        mread_image(-1, (const char *) 0, 0);
+        levstore_reading = -1;
+    }
+}
+
+/* make sure every stored level also exists as a level file; unless
+   forced, not more often than every sysopt.levelstore_ckpt turns */
+void
+levelstore_checkpoint(force)
+boolean force;
+{
+    static long last_ckpt = 0L;
+    struct levstore *ls;
+
+    if (force)
+        levio_sync();
+    else
+        levio_collect();
+    if (!force && sysopt.levelstore_ckpt > 0
+        && moves < last_ckpt + sysopt.levelstore_ckpt)
+        return;
+    last_ckpt = moves;
+    for (ls = levstore; ls; ls = ls->next)
+        if (ls->dirty && !ls->writing)
+            (void) levstore_spill(ls);
+}
+
+#ifdef LEVELIO_THREAD
+/* body of the I/O thread */
+STATIC_OVL genericptr_t
+levio_main(arg)
+genericptr_t arg UNUSED;
+{
+    struct levio *job;
+    sigset_t sigs;
+
+    /* signals are for the game to deal with */
+    (void) sigfillset(&sigs);
+    (void) pthread_sigmask(SIG_BLOCK, &sigs, (sigset_t *) 0);
+    (void) pthread_mutex_lock(&levio_lock);
+    for (;;) {
+        for (job = levio_jobs; job; job = job->next)
+            if (job->state == LIO_QUEUED)
+                break;
+        if (!job) {
+            (void) pthread_cond_wait(&levio_work, &levio_lock);
+            continue;
+        }
+        job->state = LIO_BUSY;
+        (void) pthread_mutex_unlock(&levio_lock);
+        levio_do(job);
+        (void) pthread_mutex_lock(&levio_lock);
+        job->state = LIO_DONE;
+        (void) pthread_cond_broadcast(&levio_done);
+    }
+    /*NOTREACHED*/
+    return (genericptr_t) 0;
+}
+
+/* the file system part of a job; runs in the I/O thread */
+STATIC_OVL void
+levio_do(job)
+struct levio *job;
+{
+    unsigned size;
+    char *newdata;
+    int fd, n;
+
+    job->err = 0;
+    if (!job->reading) {
+        if ((fd = creat(job->path, FCMASK)) < 0) {
+            job->err = errno;
+            return;
+        }
+        for (size = 0; size < job->len; size += (unsigned) n)
+            if ((n = (int) write(fd, job->data + size, job->len - size))
+                <= 0) {
+                job->err = n < 0 ? errno : ENOSPC;
+                break;
+            }
+        if (close(fd) < 0 && !job->err)
+            job->err = errno;
+        return;
+    }
+    if ((fd = open(job->path, O_RDONLY | O_BINARY, 0)) < 0) {
+        job->err = errno;
+        return;
+    }
+    size = 16 * BUFSZ;
+    job->data = (char *) malloc(size);
+    job->len = 0;
+    while (job->data) {
+        if (job->len == size) {
+            if (!(newdata = (char *) realloc(job->data, size * 2))) {
+                free(job->data), job->data = 0;
+                break;
+            }
+            job->data = newdata, size *= 2;
+        }
+        if ((n = (int) read(fd, job->data + job->len, size - job->len)) <= 0)
+            break;
+        job->len += (unsigned) n;
+    }
+    if (!job->data || n < 0)
+        job->err = job->data ? errno : ENOMEM;
+    (void) close(fd);
+}
+
+STATIC_OVL boolean
+levio_start()
+{
+    pthread_t tid;
+
+    if (!levio_thread)
+        levio_thread = pthread_create(&tid, (const pthread_attr_t *) 0,
+                                      levio_main, (genericptr_t) 0)
+                           ? -1 : 1;
+    return (boolean) (levio_thread > 0);
+}
+
+/* add a job to the end of the queue: write out, or read in if data is
+   null, the file of level lev */
+STATIC_OVL void
+levio_queue(lev, owned, data, len)
+int lev;
+boolean owned;
+char *data;
+unsigned len;
+{
+    struct levio *job = (struct levio *) alloc(sizeof *job), **tail;
+
+    set_levelfile_name(lock, lev);
+    job->path = dupstr(fqname(lock, LEVELPREFIX, 0));
+    job->lev = lev;
+    job->state = LIO_QUEUED;
+    job->reading = !data;
+    job->owned = owned;
+    job->err = 0;
+    job->data = data;
+    job->len = len;
+    job->next = 0;
+    (void) pthread_mutex_lock(&levio_lock);
+    for (tail = &levio_jobs; *tail; tail = &(*tail)->next)
+        continue;
+    *tail = job;
+    (void) pthread_cond_signal(&levio_work);
+    (void) pthread_mutex_unlock(&levio_lock);
+}
+
+/* wait until no job for level lev (any level if lev is -1) is queued or
+   under way, then deal with the finished ones; with cancel, jobs which
+   haven't been started are dropped instead */
+STATIC_OVL void
+levio_wait(lev, cancel)
+int lev;
+boolean cancel;
+{
+    struct levio *job;
+
+    if (levio_thread <= 0)
+        return;
+    (void) pthread_mutex_lock(&levio_lock);
+    for (;;) {
+        for (job = levio_jobs; job; job = job->next) {
+            if (lev >= 0 && job->lev != lev)
+                continue;
+            if (job->state == LIO_QUEUED && cancel) {
+                job->state = LIO_DONE;
+                job->err = -1;
+            }
+            if (job->state != LIO_DONE)
+                break;
+        }
+        if (!job)
+            break;
+        (void) pthread_cond_wait(&levio_done, &levio_lock);
+    }
+    (void) pthread_mutex_unlock(&levio_lock);
+    levio_collect();
+}
+
+/* take finished jobs off the queue:  a written level is now on disk, a
+   read one goes into the level store */
+STATIC_OVL void
+levio_collect()
+{
+    struct levio *job, **prev, *done = 0;
+    struct levstore *ls;
+
+    if (levio_thread <= 0)
+        return;
+    (void) pthread_mutex_lock(&levio_lock);
+    for (prev = &levio_jobs; (job = *prev) != 0;)
+        if (job->state == LIO_DONE) {
+            *prev = job->next;
+            job->next = done;
+            done = job;
+        } else
+            prev = &job->next;
+    (void) pthread_mutex_unlock(&levio_lock);
+
+    while ((job = done) != 0) {
+        done = job->next;
+        ls = levstore_find(job->lev);
+        if (!job->reading) {
+            if (ls && ls->data == job->data) {
+                ls->writing = FALSE;
+                ls->dirty = (job->err != 0);
+            }
+            if (job->err > 0)
+                impossible("Cannot write level %d (errno %d).", job->lev,
+                           job->err);
+            if (job->owned)
+                free((genericptr_t) job->data);
+        } else if (!job->err && !ls
+                   && (level_info[job->lev].flags & LFILE_EXISTS)) {
+            ls = (struct levstore *) alloc(sizeof *ls);
+            ls->lev = job->lev;
+            ls->data = job->data;
+            ls->len = job->len;
+            ls->used = ++levstore_clock;
+            ls->dirty = ls->writing = FALSE;
+            ls->nearby = TRUE;
+            ls->next = levstore;
+            levstore = ls;
+            levstore_bytes += (long) ls->len;
+        } else if (job->data) {
+            free((genericptr_t) job->data); /* stale or failed */
+        }
+        free((genericptr_t) job->path);
+        free((genericptr_t) job);
+    }
+    levstore_trim();
+}
+#endif /* LEVELIO_THREAD */
+
+/* after a level change, keep the saved levels above, below and across
+   the branch stairs from the hero's in the level store, reading in any
+   which aren't there yet */
+void
+levelio_prefetch()
+{
+#ifdef LEVELIO_THREAD
+    int want[3], nwant = 0, i;
+    struct levstore *ls;
+    struct levio *job;
+    d_level lev;
+
+    if (!levio_start())
+        return;
+    levio_collect();
+    assign_level(&lev, &u.uz);
+    if (dunlev(&u.uz) > 1) {
+        lev.dlevel = dunlev(&u.uz) - 1;
+        want[nwant++] = ledger_no(&lev);
+    }
+    if (dunlev(&u.uz) < dunlevs_in_dungeon(&u.uz)) {
+        lev.dlevel = dunlev(&u.uz) + 1;
+        want[nwant++] = ledger_no(&lev);
+    }
+    if (sstairs.sx && sstairs.tolev.dnum != u.uz.dnum)
+        want[nwant++] = ledger_no(&sstairs.tolev);
+
+    for (ls = levstore; ls; ls = ls->next)
+        ls->nearby = FALSE;
+    for (i = 0; i < nwant; i++) {
+        if ((ls = levstore_find(want[i])) != 0) {
+            ls->nearby = TRUE;
+            continue;
+        }
+        if (!(level_info[want[i]].flags & LFILE_EXISTS))
+            continue;
+        (void) pthread_mutex_lock(&levio_lock);
+        for (job = levio_jobs; job; job = job->next)
+            if (job->lev == want[i] && job->reading)
+                break;
+        (void) pthread_mutex_unlock(&levio_lock);
+        if (!job)
+            levio_queue(want[i], TRUE, (char *) 0, 0);
+    }
+    levstore_trim(); /* let go of the levels we've moved away from */
+#endif
+}
+
 int
 create_levelfile(lev, errbuf)
 int lev;
 char errbuf[];
+{
+    boolean threaded = levio_start();
+
+    if ((sysopt.levelstore > 0L || threaded) && levstore_writing < 0
+        && (lev > 0 || (lev == 0 && threaded))) {
+        if (errbuf)
+            *errbuf = '\0';
+        levio_wait(lev, FALSE);
+        levstore_writing = lev;
+        bwrite_image(LEVSTORE_FD);
+        level_info[lev].flags |= LFILE_EXISTS;
+        return LEVSTORE_FD;
+    }
+    levio_wait(lev, FALSE);
+    return create_levelfile_disk(lev, errbuf);
+}
+
+STATIC_OVL int
+create_levelfile_disk(lev, errbuf)
+int lev;
+char errbuf[];
 {
     int fd;
     const char *fq_lock;
@@ -516,9 +1042,9 @@ char errbuf[];
 #endif
 #endif /* MICRO || WIN32 */
 
-    if (fd >= 0)
+    if (fd >= 0) {
         level_info[lev].flags |= LFILE_EXISTS;
-    else if (errbuf) /* failure explanation */
+    } else if (errbuf) /* failure explanation */
         Sprintf(errbuf, "Cannot create file \"%s\" for level %d (errno %d).",
                 lock, lev, errno);
 
@@ -532,9 +1058,17 @@ char errbuf[];
 {
     int fd;
     const char *fq_lock;
+    struct levstore *ls;
 
     if (errbuf)
         *errbuf = '\0';
+    levio_wait(lev, FALSE);
+    if ((ls = levstore_find(lev)) != 0 && levstore_reading < 0) {
+        ls->used = ++levstore_clock;
+        levstore_reading = lev;
+        mread_image(LEVSTORE_FD, ls->data, ls->len);
+        return LEVSTORE_FD;
+    }
     set_levelfile_name(lock, lev);
     fq_lock = fqname(lock, LEVELPREFIX, 0);
 #ifdef MFLOPPY
@@ -571,6 +1105,7 @@ int lev;
      * Level 0 might be created by port specific code that doesn't
      * call create_levfile(), so always assume that it exists.
      */
+    levio_wait(lev, TRUE);
     if (lev == 0 || (level_info[lev].flags & LFILE_EXISTS)) {
         set_levelfile_name(lock, lev);
 #ifdef HOLD_LOCKFILE_OPEN
@@ -580,14 +1115,88 @@ int lev;
         (void) unlink(fqname(lock, LEVELPREFIX, 0));
         level_info[lev].flags &= ~LFILE_EXISTS;
     }
+    levstore_free(lev);
+}
+
+/*
+ * A level file that goto_level() is about to restore is read into memory
+ * in one go and getlev() decodes it from there, instead of issuing one
+ * read() per structure.  The file itself stays the authoritative copy.
+ */
+static struct levimg {
+    int lev;       /* ledger number */
+    unsigned len;  /* bytes in data[] */
+    char *data;
+} attached_img = { 0, 0, (char *) 0 };
+
+/* read all of an open level file into memory */
+STATIC_OVL char *
+slurp_levelfile(fd, lenp)
+int fd;
+unsigned *lenp;
+{
+    unsigned len = 0, size = 16 * BUFSZ;
+    char *data = (char *) alloc(size), *newdata;
+    int rlen;
+
+    for (;;) {
+        if (len == size) {
+            newdata = (char *) alloc(size * 2);
+            (void) memcpy((genericptr_t) newdata, (genericptr_t) data, len);
+            free((genericptr_t) data);
+            data = newdata, size *= 2;
+        }
+        rlen = read(fd, data + len, size - len);
+        if (rlen <= 0)
+            break;
+        len += (unsigned) rlen;
+    }
+    *lenp = len;
+    return data;
+}
+
+/* make the level file open as fd for ledger lev readable via mread()
+   from memory */
+void
+attach_levelfile(lev, fd)
+int lev, fd;
+{
+    if (fd == LEVSTORE_FD)
+        return; /* open_levelfile() attached the stored image */
+    detach_levelfile();
+    attached_img.lev = lev;
+    attached_img.data = slurp_levelfile(fd, &attached_img.len);
+    mread_image(fd, attached_img.data, attached_img.len);
+}
+
+void
+detach_levelfile()
+{
+    mread_image(-1, (const char *) 0, 0);
+    if (attached_img.data)
+        free((genericptr_t) attached_img.data);
+    attached_img.data = (char *) 0;
+    attached_img.lev = 0, attached_img.len = 0;
+}
+
+void
+free_levelimages()
+{
+    detach_levelfile();
+    levio_sync();
+    while (levstore)
+        levstore_free(levstore->lev);
 }
 
 void
 clearlocks()
 {
+    levio_sync(); /* nothing half written or still to be written */
 #ifdef HANGUPHANDLING
-    if (program_state.preserve_locks)
+    if (program_state.preserve_locks) {
+        levelstore_checkpoint(TRUE); /* recover needs them as files */
         return;
+    }
 #endif
 #if !defined(PC_LOCKING) && defined(MFLOPPY) && !defined(AMIGA)
     eraseall(levels, alllevels);
@@ -683,6 +1292,10 @@ int
 nhclose(fd)
 int fd;
 {
+    if (fd == LEVSTORE_FD) {
+        levstore_close();
+        return 0;
+    }
     if (lftrack.fd == fd) {
         really_close(); /* close it, but reopen it to hold it */
         fd = open_levelfile(0, (char *) 0);
@@ -697,6 +1310,10 @@ int
 nhclose(fd)
 int fd;
 {
+    if (fd == LEVSTORE_FD) {
+        levstore_close();
+        return 0;
+    }
     return close(fd);
 }
 #endif /* ?HOLD_LOCKFILE_OPEN */
@@ -964,7 +1581,7 @@ void
 save_savefile_name(fd)
 int fd;
 {
-    (void) write(fd, (genericptr_t) SAVEF, sizeof(SAVEF));
+    bwrite(fd, (genericptr_t) SAVEF, sizeof(SAVEF));
 }
 #endif
 
@@ -1043,6 +1660,7 @@ int
 delete_savefile()
 {
     (void) unlink(fqname(SAVEF, SAVEPREFIX, 0));
+    update_saveindex((struct save_summary *) 0);
     return 0; /* for restore_saved_game() (ex-xxxmain.c) test */
 }
 
@@ -1079,6 +1697,8 @@ const char *filename;
 {
     int fd;
     char *result = 0;
+    char tplname[PL_NSIZ];
+    struct save_summary ss;
 
     Strcpy(SAVEF, filename);
 #ifdef COMPRESS_EXTENSION
@@ -1087,13 +1707,17 @@ const char *filename;
     nh_uncompress(SAVEF);
     if ((fd = open_savefile()) >= 0) {
         if (validate(fd, filename) == 0) {
-            char tplname[PL_NSIZ];
-            get_plname_from_file(fd, tplname);
+            get_plname_from_file(fd, tplname, &ss);
             result = dupstr(tplname);
         }
         (void) nhclose(fd);
     }
     nh_compress(SAVEF);
+#ifdef SAVEINDEX
+    /* get_saved_games() is rebuilding the index */
+    if (result && idx_rebuild)
+        saveindex_collect(saveindex_entry(SAVEF, &ss));
+#endif
 
     return result;
 #if 0
@@ -1134,6 +1758,16 @@ get_saved_games()
 #if defined(SELECTSAVED)
     int n, j = 0;
     char **result = 0;
+#ifdef SAVEINDEX
+    char owner[BUFSZ], marker[BUFSZ + 2];
+    int fd;
+
+    if (read_saveindex(&result, &j))
+        goto sort_saved;
+    /* the index is missing or stale; scan the save files and rebuild
+       this player's part of it */
+    idx_rebuild = TRUE;
+#endif
 #ifdef WIN32
     {
         char *foundfile;
@@ -1213,6 +1847,22 @@ get_saved_games()
     set_savefile_name(FALSE);
     j = vms_get_saved_games(SAVEF, &result);
 #endif /* VMS */
+#ifdef SAVEINDEX
+    idx_rebuild = FALSE;
+    if ((fd = open(fqname(SAVEINDEX, SAVEPREFIX, 0), O_WRONLY | O_CREAT,
+                   FCMASK)) >= 0) {
+        (void) nhclose(fd);
+        saveindex_owner(owner);
+        Sprintf(marker, "\t%s\n", owner);
+        saveindex_collect(dupstr(marker));
+        rewrite_saveindex((char *) 0, owner, idx_scan, idx_nscan);
+    }
+    while (idx_nscan > 0)
+        free((genericptr_t) idx_scan[--idx_nscan]);
+    if (idx_scan)
+        free((genericptr_t) idx_scan), idx_scan = 0, idx_scanmax = 0;
+ sort_saved:
+#endif
 
     if (j > 0) {
         if (j > 1)
@@ -1431,6 +2081,9 @@ const char *filename UNUSED_if_not_COMPRESS;
 #pragma unused(filename)
 #endif
 #else
+    /* data written by the lzcomp suite is already compressed */
+    if ((sfsaveinfo.sfi1 & SFI1_LZCOMP) != 0)
+        return;
     docompress_file(filename, FALSE);
 #endif
 }
@@ -1872,6 +2525,258 @@ const char *filename;
 
 /* ----------  END FILE LOCKING HANDLING ----------- */
 
+/* ----------  BEGIN SAVE INDEX HANDLING ----------- */
+
+#ifdef SAVEINDEX
+/* add a line to the set being gathered by get_saved_games() */
+STATIC_OVL void
+saveindex_collect(line)
+char *line;
+{
+    if (idx_nscan == idx_scanmax) {
+        char **old = idx_scan;
+
+        idx_scanmax = idx_scanmax ? 2 * idx_scanmax : 64;
+        idx_scan = (char **) alloc(idx_scanmax * sizeof (char *));
+        if (old) {
+            (void) memcpy((genericptr_t) idx_scan, (genericptr_t) old,
+                          idx_nscan * sizeof (char *));
+            free((genericptr_t) old);
+        }
+    }
+    idx_scan[idx_nscan++] = line;
+}
+
+/* the part of SAVEF that is the same for all of this player's games */
+STATIC_OVL void
+saveindex_owner(buf)
+char *buf;
+{
+    char savef[SAVESIZE], name[PL_NSIZ], *p;
+
+    Strcpy(savef, SAVEF);
+    Strcpy(name, plname);
+    Strcpy(plname, "*");
+    set_savefile_name(FALSE);
+    Strcpy(buf, SAVEF);
+    if ((p = index(buf, '*')) != 0)
+        *p = '\0';
+    Strcpy(SAVEF, savef);
+    Strcpy(plname, name);
+}
+
+STATIC_OVL long
+savefile_mtime(file)
+const char *file;
+{
+    struct stat st;
+
+    if (!stat(fqname(file, SAVEPREFIX, 1), &st))
+        return (long) st.st_mtime;
+#ifdef COMPRESS_EXTENSION
+    {
+        char cfile[SAVESIZE + sizeof COMPRESS_EXTENSION];
+
+        Strcpy(cfile, file);
+        Strcat(cfile, COMPRESS_EXTENSION);
+        if (!stat(fqname(cfile, SAVEPREFIX, 1), &st))
+            return (long) st.st_mtime;
+    }
+#endif
+    return 0L;
+}
+
+/* break an index line into its fields in place; returns the count */
+STATIC_OVL int
+saveindex_split(line, fld)
+char *line;
+char **fld;
+{
+    int n = 0;
+    char *p;
+
+    if ((p = index(line, '\n')) != 0)
+        *p = '\0';
+    fld[n++] = line;
+    for (p = line; *p && n < SAVEINDEX_FIELDS; p++)
+        if (*p == '\t')
+            *p = '\0', fld[n++] = p + 1;
+    return n;
+}
+
+/* format the index line for a save file; the result is malloc'd */
+STATIC_OVL char *
+saveindex_entry(file, ss)
+const char *file;
+struct save_summary *ss;
+{
+    char buf[BUFSZ * 2], owner[BUFSZ], name[PL_NSIZ], *p;
+
+    saveindex_owner(owner);
+    Strcpy(name, ss->plname);
+    for (p = name; *p; p++)
+        if (*p == '\t' || *p == '\n')
+            *p = ' ';
+    Sprintf(buf, "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%ld\t%ld\t%ld\n", file, owner,
+            name, ss->role, ss->race, ss->gender, ss->align, ss->depth,
+            ss->moves, savefile_mtime(file));
+    return dupstr(buf);
+}
+
+/* drop the entry for match_file, or when rebuilding, all of match_owner's
+   entries and every owner's indexed marker; then append add[] */
+STATIC_OVL void
+rewrite_saveindex(match_file, match_owner, add, nadd)
+const char *match_file, *match_owner;
+char **add;
+int nadd;
+{
+    FILE *fp;
+    char line[BUFSZ * 2], tmp[BUFSZ * 2], *fld[SAVEINDEX_FIELDS];
+    char **keep = 0;
+    int i, n, nkeep = 0, maxkeep = 0;
+
+    /* already holding another lock (e.g. during topten), or never built */
+    if (nesting || !(fp = fopen_datafile(SAVEINDEX, "r", SAVEPREFIX)))
+        return;
+    (void) fclose(fp);
+    if (!lock_file(SAVEINDEX, SAVEPREFIX, 10))
+        return;
+
+    if ((fp = fopen_datafile(SAVEINDEX, "r", SAVEPREFIX)) != 0) {
+        while (fgets(line, sizeof line, fp)) {
+            Strcpy(tmp, line);
+            n = saveindex_split(tmp, fld);
+            if (n < 2)
+                continue;
+            if (match_file && !strcmp(fld[0], match_file))
+                continue;
+            if (match_owner && (!*fld[0] || !strcmp(fld[1], match_owner)))
+                continue;
+            if (nkeep == maxkeep) {
+                char **old = keep;
+
+                maxkeep = maxkeep ? 2 * maxkeep : 64;
+                keep = (char **) alloc(maxkeep * sizeof (char *));
+                if (old) {
+                    (void) memcpy((genericptr_t) keep, (genericptr_t) old,
+                                  nkeep * sizeof (char *));
+                    free((genericptr_t) old);
+                }
+            }
+            keep[nkeep++] = dupstr(line);
+        }
+        (void) fclose(fp);
+    }
+
+    if ((fp = fopen_datafile(SAVEINDEX, "w", SAVEPREFIX)) != 0) {
+        for (i = 0; i < nkeep; i++)
+            (void) fputs(keep[i], fp);
+        for (i = 0; i < nadd; i++)
+            (void) fputs(add[i], fp);
+        (void) fclose(fp);
+    }
+    unlock_file(SAVEINDEX);
+
+    for (i = 0; i < nkeep; i++)
+        free((genericptr_t) keep[i]);
+    if (keep)
+        free((genericptr_t) keep);
+}
+
+/* list this player's saved games from the index; FALSE if it can't be
+   trusted and the save directory has to be scanned instead */
+STATIC_OVL boolean
+read_saveindex(resultp, countp)
+char ***resultp;
+int *countp;
+{
+    FILE *fp;
+    struct stat ist;
+    char line[BUFSZ * 2], owner[BUFSZ], *fld[SAVEINDEX_FIELDS];
+    char **result = 0;
+    int n, j = 0, max = 0;
+    boolean indexed = FALSE;
+
+    if (stat(fqname(SAVEINDEX, SAVEPREFIX, 0), &ist))
+        return FALSE;
+#ifdef UNIX
+    {
+        struct stat dst;
+
+        /* files came or went behind the index's back */
+        if (stat(fqname("save", SAVEPREFIX, 0), &dst)
+            || dst.st_mtime > ist.st_mtime)
+            return FALSE;
+    }
+#endif
+    if (!lock_file(SAVEINDEX, SAVEPREFIX, 10))
+        return FALSE;
+    if (!(fp = fopen_datafile(SAVEINDEX, "r", SAVEPREFIX))) {
+        unlock_file(SAVEINDEX);
+        return FALSE;
+    }
+    saveindex_owner(owner);
+    while (fgets(line, sizeof line, fp)) {
+        n = saveindex_split(line, fld);
+        if (n < 2 || strcmp(fld[1], owner))
+            continue;
+        if (!*fld[0]) {
+            indexed = TRUE;
+            continue;
+        }
+        if (n < 3)
+            continue;
+        if (j + 1 >= max) {
+            char **old = result;
+
+            max = max ? 2 * max : 16;
+            result = (char **) alloc(max * sizeof (char *));
+            if (old) {
+                (void) memcpy((genericptr_t) result, (genericptr_t) old,
+                              j * sizeof (char *));
+                free((genericptr_t) old);
+            }
+        }
+        result[j++] = dupstr(fld[2]);
+    }
+    (void) fclose(fp);
+    unlock_file(SAVEINDEX);
+
+    if (!indexed) {
+        while (j > 0)
+            free((genericptr_t) result[--j]);
+        if (result)
+            free((genericptr_t) result);
+        return FALSE;
+    }
+    if (result)
+        result[j] = 0;
+    *resultp = result;
+    *countp = j;
+    return TRUE;
+}
+#endif /* SAVEINDEX */
+
+/* keep the save index in step with the current save file; ss is null
+   when that file has been deleted */
+void
+update_saveindex(ss)
+struct save_summary *ss;
+{
+#ifdef SAVEINDEX
+    char *entry = ss ? saveindex_entry(SAVEF, ss) : (char *) 0;
+
+    rewrite_saveindex(SAVEF, (char *) 0, &entry, entry ? 1 : 0);
+    if (entry)
+        free((genericptr_t) entry);
+#else
+    nhUse(ss);
+#endif
+}
+
+/* ----------  END SAVE INDEX HANDLING ----------- */
+
 /* ----------  BEGIN CONFIG FILE HANDLING ----------- */
 
 const char *default_configfile =
@@ -2425,6 +3330,18 @@ char *origbuf;
         /* note: right now bones_pools==0 is the same as bones_pools==1,
            but we could change that and make bones_pools==0 become an
            indicator to suppress bones usage altogether */
+    } else if (src == SET_IN_SYS && match_varname(buf, "LEVELSTORE", 10)) {
+        /* kilobytes of level data kept in memory instead of level files */
+        n = atoi(bufp);
+        if (n < 0) {
+            config_error_add("Illegal value in LEVELSTORE (minimum is 0).");
+            return FALSE;
+        }
+        sysopt.levelstore = (long) n * 1024L;
+    } else if (src == SET_IN_SYS
+               && match_varname(buf, "LEVELSTORE_CHECKPOINT", 21)) {
+        n = atoi(bufp);
+        sysopt.levelstore_ckpt = (n <= 0) ? 0 : n;
     } else if (src == SET_IN_SYS && match_varname(buf, "SUPPORT", 7)) {
         if (sysopt.support)
             free((genericptr_t) sysopt.support);
@@ -3586,6 +4503,8 @@ recover_savefile()
     int processed[256];
     char savename[SAVESIZE], errbuf[BUFSZ];
     struct savefile_info sfi;
+    unsigned char toc[6 + MAXCHUNKTOC * CHUNKTOC_ENTSZ];
+    int toclen = 0;
     char tmpplbuf[PL_NSIZ];
 
     for (lev = 0; lev < 256; lev++)
@@ -3596,6 +4515,7 @@ recover_savefile()
      *  level number for current level of save file
      *  name of save file nethack would have created
      *  savefile info
+     *  chunk table of contents, if any
      *  player name
      *  and game state
      */
@@ -3624,6 +4544,12 @@ recover_savefile()
         || (read(gfd, (genericptr_t) &version_data, sizeof version_data)
             != sizeof version_data)
         || (read(gfd, (genericptr_t) &sfi, sizeof sfi) != sizeof sfi)
+        || ((sfi.sfi2 & SFI2_CHUNKS) != 0
+            && (read(gfd, (genericptr_t) toc, 6) != 6
+                || (toclen = 6 + (toc[4] | (toc[5] << 8)) * CHUNKTOC_ENTSZ)
+                       > (int) sizeof toc
+                || read(gfd, (genericptr_t) &toc[6], toclen - 6)
+                       != toclen - 6))
         || (read(gfd, (genericptr_t) &pltmpsiz, sizeof pltmpsiz)
             != sizeof pltmpsiz) || (pltmpsiz > PL_NSIZ)
         || (read(gfd, (genericptr_t) &tmpplbuf, pltmpsiz) != pltmpsiz)) {
@@ -3635,6 +4561,7 @@ recover_savefile()
     /* save file should contain:
      *  version info
      *  savefile info
+     *  chunk table of contents, if any
      *  player name
      *  current level (including pets)
      *  (non-level-based) game state
@@ -3667,6 +4594,8 @@ recover_savefile()
         return FALSE;
     }
 
+    /* lock files carry no game summary, so neither will the result */
+    sfi.sfi2 &= ~SFI2_SAVEINFO;
     if (write(sfd, (genericptr_t) &sfi, sizeof sfi) != sizeof sfi) {
         raw_printf("\nError writing %s; recovery failed (savefile_info).\n",
                    SAVEF);
@@ -3677,6 +4606,17 @@ recover_savefile()
         return FALSE;
     }
 
+    if (toclen && write(sfd, (genericptr_t) toc, toclen) != toclen) {
+        raw_printf(
+               "\nError writing %s; recovery failed (table of contents).\n",
+                   SAVEF);
+        (void) nhclose(gfd);
+        (void) nhclose(sfd);
+        (void) nhclose(lfd);
+        delete_savefile();
+        return FALSE;
+    }
+
     if (write(sfd, (genericptr_t) &pltmpsiz, sizeof pltmpsiz)
         != sizeof pltmpsiz) {
         raw_printf("Error writing %s; recovery failed (player name size).\n",
@@ -1998,7 +1998,7 @@ boolean newspot;             /* true if called by spoteffects */
 
             u.uinwater = 0;       /* leave the water */
             if (was_underwater) { /* restore vision */
-                docrt();
+                refresh_map();
                 vision_full_recalc = 1;
             }
         }
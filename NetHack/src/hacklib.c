@@ -52,6 +52,7 @@
                                          const char *, boolean)
         void            setrandom       (void)
         time_t          getnow          (void)
+        long            cputime_ms      (void)
         int             getyear         (void)
         char *          yymmdd          (time_t)
         long            yyyymmdd        (time_t)
@@ -866,6 +867,17 @@ setrandom()
     }
 #endif
 
+    set_random(seed);
+}
+
+/* seed the random number generators with a known value, so that a game
+   can be played over again */
+void
+set_random(seed)
+unsigned long seed;
+{
+    init_rng(seed); /* the game's own, see rnd.c */
+
     /* the types are different enough here that sweeping the different
      * routine names into one via #defines is even more confusing
      */
@@ -897,6 +909,13 @@ getnow()
     return datetime;
 }
 
+/* processor time used so far, in milliseconds; for timing loops */
+long
+cputime_ms()
+{
+    return (long) ((double) clock() * 1000.0 / (double) CLOCKS_PER_SEC);
+}
+
 STATIC_OVL struct tm *
 getlt()
 {
@@ -4,6 +4,7 @@
 
 #include "hack.h"
 #include "lev.h" /* for checking save modes */
+#include "integer.h"
 
 /*
  * Mobile light sources.
@@ -25,12 +26,11 @@
  * The major working function is do_light_sources(). It is called
  * when the vision system is recreating its "could see" array.  Here
  * we add a flag (TEMP_LIT) to the array for all locations that are lit
- * via a light source.  The bad part of this is that we have to
- * re-calculate the LOS of each light source every time the vision
- * system runs.  Even if the light sources and any topology (vision blocking
- * positions) have not changed.  The good part is that no extra memory
- * is used, plus we don't have to figure out how far the sources have moved,
- * or if the topology has changed.
+ * via a light source.  Each source remembers the locations it lit the
+ * last time its lines of sight were traced, and reuses them until it
+ * moves, its range changes, or block_point()/unblock_point() changes a
+ * location within its range (see light_block_changed()).  Sources at
+ * the hero's position use the vision system's own COULD_SEE bits.
  *
  * The structure of the save/restore mechanism is amazingly similar to
  * the timer save/restore.  This is because they both have the same
@@ -42,8 +42,25 @@
 #define LSF_SHOW 0x1        /* display the light source */
 #define LSF_NEEDS_FIXUP 0x2 /* need oid fixup */
 
+/*
+ * A light source as kept in memory:  the light_source, which is all
+ * that gets saved, and the locations it lit when last traced.  Bit i of
+ * lit[j] is the location (cx - crange + i, cy - crange + j).
+ */
+typedef struct ls_node {
+    light_source ls; /* must be first */
+    boolean cached;  /* lit[] is valid for cx, cy and crange */
+    xchar cx, cy;
+    short crange;
+    uint32 lit[2 * MAX_RADIUS + 1];
+} ls_node;
+
+#define LSNODE(ls) ((ls_node *) (ls))
+
 static light_source *light_base = 0;
 
+STATIC_DCL light_source *NDECL(alloc_ls);
+STATIC_DCL void FDECL(trace_light_source, (light_source *));
 STATIC_DCL void FDECL(write_ls, (int, light_source *));
 STATIC_DCL int FDECL(maybe_write_ls, (int, int, BOOLEAN_P));
 
@@ -51,6 +68,15 @@ STATIC_DCL int FDECL(maybe_write_ls, (int, int, BOOLEAN_P));
 extern char circle_data[];
 extern char circle_start[];
 
+STATIC_OVL light_source *
+alloc_ls()
+{
+    ls_node *ln = (ls_node *) alloc(sizeof(ls_node));
+
+    ln->cached = FALSE;
+    return &ln->ls;
+}
+
 /* Create a new light source.  */
 void
 new_light_source(x, y, range, type, id)
@@ -65,7 +91,7 @@ anything *id;
         return;
     }
 
-    ls = (light_source *) alloc(sizeof(light_source));
+    ls = alloc_ls();
 
     ls->next = light_base;
     ls->x = x;
@@ -126,6 +152,45 @@ anything *id;
                fmt_ptr((genericptr_t) id->a_obj));
 }
 
+/*
+ * Walk the points in a light source's circle and remember the ones
+ * that are visible from the center.
+ *
+ * Kevin's tests indicated that doing this brute-force
+ * method is faster for radius <= 3 (or so).
+ */
+STATIC_OVL void
+trace_light_source(ls)
+light_source *ls;
+{
+    ls_node *ln = LSNODE(ls);
+    int x, y, min_x, max_x, max_y, offset, left = ls->x - ls->range;
+    char *limits;
+    uint32 mask;
+
+    (void) memset((genericptr_t) ln->lit, 0, sizeof ln->lit);
+    limits = circle_ptr(ls->range);
+    if ((max_y = (ls->y + ls->range)) >= ROWNO)
+        max_y = ROWNO - 1;
+    if ((y = (ls->y - ls->range)) < 0)
+        y = 0;
+    for (; y <= max_y; y++) {
+        offset = limits[abs(y - ls->y)];
+        if ((min_x = (ls->x - offset)) < 0)
+            min_x = 0;
+        if ((max_x = (ls->x + offset)) >= COLNO)
+            max_x = COLNO - 1;
+        for (mask = 0, x = min_x; x <= max_x; x++)
+            if ((ls->x == x && ls->y == y)
+                || clear_path((int) ls->x, (int) ls->y, x, y))
+                mask |= (uint32) 1 << (x - left);
+        ln->lit[y - (ls->y - ls->range)] = mask;
+    }
+    ln->cx = ls->x, ln->cy = ls->y;
+    ln->crange = ls->range;
+    ln->cached = TRUE;
+}
+
 /* Mark locations that are temporarily lit via mobile light sources. */
 void
 do_light_sources(cs_rows)
@@ -135,16 +200,16 @@ char **cs_rows;
     char *limits;
     short at_hero_range = 0;
     light_source *ls;
+    ls_node *ln;
     char *row;
+    uint32 mask;
 
     for (ls = light_base; ls; ls = ls->next) {
         ls->flags &= ~LSF_SHOW;
 
         /*
-         * Check for moved light sources.  It may be possible to
-         * save some effort if an object has not moved, but not in
-         * the current setup -- we need to recalculate for every
-         * vision recalc.
+         * Check for moved light sources.  Their cached circles are
+         * only used if they are still where they were traced.
          */
         if (ls->type == LS_OBJECT) {
             if (get_obj_location(ls->id.a_obj, &ls->x, &ls->y, 0))
@@ -163,13 +228,20 @@ char **cs_rows;
                 at_hero_range = ls->range;
         }
 
-        if (ls->flags & LSF_SHOW) {
+        if (!(ls->flags & LSF_SHOW))
+            continue;
+
+        if (ls->x == u.ux && ls->y == u.uy) {
             /*
-             * Walk the points in the circle and see if they are
-             * visible from the center.  If so, mark'em.
-             *
-             * Kevin's tests indicated that doing this brute-force
-             * method is faster for radius <= 3 (or so).
+             * If the light source is located at the hero, then
+             * we can use the COULD_SEE bits already calculated
+             * by the vision system.  More importantly than
+             * this optimization, is that it allows the vision
+             * system to correct problems with clear_path().
+             * The function clear_path() is a simple LOS
+             * path checker that doesn't go out of its way
+             * make things look "correct".  The vision system
+             * does this.
              */
             limits = circle_ptr(ls->range);
             if ((max_y = (ls->y + ls->range)) >= ROWNO)
@@ -183,33 +255,46 @@ char **cs_rows;
                     min_x = 0;
                 if ((max_x = (ls->x + offset)) >= COLNO)
                     max_x = COLNO - 1;
-
-                if (ls->x == u.ux && ls->y == u.uy) {
-                    /*
-                     * If the light source is located at the hero, then
-                     * we can use the COULD_SEE bits already calculated
-                     * by the vision system.  More importantly than
-                     * this optimization, is that it allows the vision
-                     * system to correct problems with clear_path().
-                     * The function clear_path() is a simple LOS
-                     * path checker that doesn't go out of its way
-                     * make things look "correct".  The vision system
-                     * does this.
-                     */
-                    for (x = min_x; x <= max_x; x++)
-                        if (row[x] & COULD_SEE)
-                            row[x] |= TEMP_LIT;
-                } else {
-                    for (x = min_x; x <= max_x; x++)
-                        if ((ls->x == x && ls->y == y)
-                            || clear_path((int) ls->x, (int) ls->y, x, y))
-                            row[x] |= TEMP_LIT;
-                }
+                for (x = min_x; x <= max_x; x++)
+                    if (row[x] & COULD_SEE)
+                        row[x] |= TEMP_LIT;
+            }
+        } else {
+            ln = LSNODE(ls);
+            if (!ln->cached || ln->cx != ls->x || ln->cy != ls->y
+                || ln->crange != ls->range)
+                trace_light_source(ls);
+            for (y = 0; y <= 2 * ls->range; y++) {
+                if (!(mask = ln->lit[y]))
+                    continue;
+                row = cs_rows[ls->y - ls->range + y] + (ls->x - ls->range);
+                for (x = 0; mask; x++, mask >>= 1)
+                    if (mask & 1)
+                        row[x] |= TEMP_LIT;
             }
         }
     }
 }
 
+/* block_point() or unblock_point() has changed <x,y>; forget the traced
+   circles of light sources close enough to have a line of sight across
+   it, or of all of them if x is -1 (vision_reset()) */
+void
+light_block_changed(x, y)
+int x, y;
+{
+    light_source *ls;
+    ls_node *ln;
+
+    for (ls = light_base; ls; ls = ls->next) {
+        ln = LSNODE(ls);
+        if (ln->cached
+            && (x < 0 || (abs(x - ln->cx) <= ln->crange
+                          && abs(y - ln->cy) <= ln->crange)))
+            ln->cached = FALSE;
+    }
+}
+
 /* (mon->mx == 0) implies migrating */
 #define mon_is_local(mon) ((mon)->mx > 0)
 
@@ -218,23 +303,9 @@ find_mid(nid, fmflags)
 unsigned nid;
 unsigned fmflags;
 {
-    struct monst *mtmp;
-
     if (!nid)
         return &youmonst;
-    if (fmflags & FM_FMON)
-        for (mtmp = fmon; mtmp; mtmp = mtmp->nmon)
-            if (!DEADMONSTER(mtmp) && mtmp->m_id == nid)
-                return mtmp;
-    if (fmflags & FM_MIGRATE)
-        for (mtmp = migrating_mons; mtmp; mtmp = mtmp->nmon)
-            if (mtmp->m_id == nid)
-                return mtmp;
-    if (fmflags & FM_MYDOGS)
-        for (mtmp = mydogs; mtmp; mtmp = mtmp->nmon)
-            if (mtmp->m_id == nid)
-                return mtmp;
-    return (struct monst *) 0;
+    return mid_index_find(nid, fmflags);
 }
 
 /* Save all light sources of the given range. */
@@ -299,7 +370,7 @@ int fd;
     mread(fd, (genericptr_t) &count, sizeof count);
 
     while (count-- > 0) {
-        ls = (light_source *) alloc(sizeof(light_source));
+        ls = alloc_ls();
         mread(fd, (genericptr_t) ls, sizeof(light_source));
         ls->next = light_base;
         light_base = ls;
@@ -319,7 +390,7 @@ long *count, *size;
     *count = *size = 0L;
     for (ls = light_base; ls; ls = ls->next) {
         ++*count;
-        *size += (long) sizeof *ls;
+        *size += (long) sizeof (ls_node);
     }
 }
 
@@ -560,7 +631,7 @@ struct obj *src, *dest;
              * never interfere us walking down the list - we are already
              * past the insertion point.
              */
-            new_ls = (light_source *) alloc(sizeof(light_source));
+            new_ls = alloc_ls();
             *new_ls = *ls;
             if (Is_candle(src)) {
                 /* split candles may emit less light than original group */
@@ -15,7 +15,8 @@
      && (mptr->msound == MS_LEADER || mptr->msound == MS_NEMESIS))
 
 STATIC_DCL boolean FDECL(uncommon, (int));
-STATIC_DCL int FDECL(align_shift, (struct permonst *));
+STATIC_DCL int FDECL(align_shift, (struct permonst *, int));
+STATIC_DCL int FDECL(mclass_range, (int, int *));
 STATIC_DCL boolean FDECL(mk_gen_ok, (int, int, int));
 STATIC_DCL boolean FDECL(wrong_elem_type, (struct permonst *));
 STATIC_DCL void FDECL(m_initgrp, (struct monst *, int, int, int));
@@ -817,6 +818,7 @@ xchar x, y; /* clone's preferred location or 0 (near mon) */
     m2->m_id = context.ident++;
     if (!m2->m_id)
         m2->m_id = context.ident++; /* ident overflowed */
+    mid_index_add(m2, FM_FMON);
     m2->mx = mm.x;
     m2->my = mm.y;
 
@@ -1177,6 +1179,7 @@ int mmflags;
     mtmp->m_id = context.ident++;
     if (!mtmp->m_id)
         mtmp->m_id = context.ident++; /* ident overflowed */
+    mid_index_add(mtmp, FM_FMON);
     set_mon_data(mtmp, ptr, 0);
     if (ptr->msound == MS_LEADER && quest_info(MS_LEADER) == mndx)
         quest_status.leader_m_id = mtmp->m_id;
@@ -1454,18 +1457,13 @@ int mndx;
  *      return an integer in the range of 0-5.
  */
 STATIC_OVL int
-align_shift(ptr)
+align_shift(ptr, dalign)
 register struct permonst *ptr;
+int dalign; /* AM_xxx alignment of the current level */
 {
-    static NEARDATA long oldmoves = 0L; /* != 1, starting value of moves */
-    static NEARDATA s_level *lev;
     register int alshift;
 
-    if (oldmoves != moves) {
-        lev = Is_special(&u.uz);
-        oldmoves = moves;
-    }
-    switch ((lev) ? lev->flags.align : dungeons[u.uz.dnum].flags.align) {
+    switch (dalign) {
     default: /* just in case */
     case AM_NONE:
         alshift = 0;
@@ -1483,10 +1481,104 @@ register struct permonst *ptr;
     return alshift;
 }
 
-static NEARDATA struct {
-    int choice_count;
-    char mchoices[SPECIAL_PM]; /* value range is 0..127 */
-} rndmonst_state = { -1, { 0 } };
+/*
+ * rndmonst() picks from a table of cumulative generation weights, so a
+ * pick is a binary search instead of a walk over all of mons[].  The
+ * weights only depend on the criteria in rndmonst_key (plus which
+ * species are gone, which reset_rndmonst() patches in place), so a few
+ * tables are kept and going back and forth between levels of differing
+ * difficulty or alignment reuses them instead of recalculating.
+ */
+#define RNDMONST_TABLES 4
+
+struct rndmonst_key {
+    int minmlev, maxmlev; /* monstr[] range */
+    int dalign;           /* AM_xxx alignment of the level */
+    int elemlev;          /* ledger_no() of an elemental plane, else 0 */
+    boolean inhell, upper; /* Gehennom; rogue level (upper case only) */
+};
+
+static NEARDATA struct rndmonst_tab {
+    struct rndmonst_key key;
+    boolean valid;
+    int cumfreq[SPECIAL_PM]; /* total weight of LOW_PM through mndx */
+} rndmonst_tabs[RNDMONST_TABLES];
+/* table matching the current criteria; null when those need rechecking */
+static NEARDATA struct rndmonst_tab *rndmonst_cur = 0;
+static NEARDATA int rndmonst_victim = 0; /* next table to be replaced */
+
+STATIC_DCL int FDECL(rndmonst_weight, (int, struct rndmonst_key *));
+STATIC_DCL struct rndmonst_tab *NDECL(rndmonst_table);
+
+/* generation weight of a species under the given criteria, 0 if excluded */
+STATIC_OVL int
+rndmonst_weight(mndx, key)
+int mndx;
+struct rndmonst_key *key;
+{
+    struct permonst *ptr = &mons[mndx];
+    int ct;
+
+    if (tooweak(mndx, key->minmlev) || toostrong(mndx, key->maxmlev))
+        return 0;
+    if (key->upper && !isupper((uchar) def_monsyms[(int) ptr->mlet].sym))
+        return 0;
+    if (key->elemlev && wrong_elem_type(ptr))
+        return 0;
+    if (uncommon(mndx))
+        return 0;
+    if (key->inhell && (ptr->geno & G_NOHELL))
+        return 0;
+    ct = (int) (ptr->geno & G_FREQ) + align_shift(ptr, key->dalign);
+    if (ct < 0 || ct > 127)
+        panic("rndmonst: bad count [#%d: %d]", mndx, ct);
+    return ct;
+}
+
+/* find or build the weight table for the current level and hero */
+STATIC_OVL struct rndmonst_tab *
+rndmonst_table()
+{
+    struct rndmonst_key key;
+    struct rndmonst_tab *tab;
+    s_level *lev = Is_special(&u.uz);
+    int i, mndx, zlevel, total;
+
+    zlevel = level_difficulty();
+    /* determine the level of the weakest monster to make. */
+    key.minmlev = zlevel / 6;
+    /* determine the level of the strongest monster to make. */
+    key.maxmlev = (zlevel + u.ulevel) / 2;
+    key.dalign = lev ? lev->flags.align : dungeons[u.uz.dnum].flags.align;
+    key.elemlev = (In_endgame(&u.uz) && !Is_astralevel(&u.uz))
+                      ? (int) ledger_no(&u.uz) : 0;
+    key.inhell = Inhell ? TRUE : FALSE;
+    key.upper = Is_rogue_level(&u.uz) ? TRUE : FALSE;
+
+    for (i = 0; i < RNDMONST_TABLES; i++) {
+        tab = &rndmonst_tabs[i];
+        if (tab->valid && tab->key.minmlev == key.minmlev
+            && tab->key.maxmlev == key.maxmlev
+            && tab->key.dalign == key.dalign
+            && tab->key.elemlev == key.elemlev
+            && tab->key.inhell == key.inhell && tab->key.upper == key.upper)
+            return tab;
+    }
+
+    tab = &rndmonst_tabs[rndmonst_victim];
+    rndmonst_victim = (rndmonst_victim + 1) % RNDMONST_TABLES;
+    tab->key = key;
+    tab->valid = TRUE;
+    for (total = 0, mndx = LOW_PM; mndx < SPECIAL_PM; mndx++) {
+        total += rndmonst_weight(mndx, &key);
+        tab->cumfreq[mndx] = total;
+    }
+    /*
+     *      Possible modification:  if the total is "too low",
+     *      expand minmlev..maxmlev range and try again.
+     */
+    return tab;
+}
 
 /* select a random monster type */
 struct permonst *
@@ -1494,78 +1586,36 @@ rndmonst()
 {
     register struct permonst *ptr;
     register int mndx, ct;
+    int lo, hi;
 
     if (u.uz.dnum == quest_dnum && rn2(7) && (ptr = qt_montype()) != 0)
         return ptr;
 
-    if (rndmonst_state.choice_count < 0) { /* need to recalculate */
-        int zlevel, minmlev, maxmlev;
-        boolean elemlevel;
-        boolean upper;
-
-        rndmonst_state.choice_count = 0;
-        /* look for first common monster */
-        for (mndx = LOW_PM; mndx < SPECIAL_PM; mndx++) {
-            if (!uncommon(mndx))
-                break;
-            rndmonst_state.mchoices[mndx] = 0;
-        }
-        if (mndx == SPECIAL_PM) {
-            /* evidently they've all been exterminated */
-            debugpline0("rndmonst: no common mons!");
-            return (struct permonst *) 0;
-        } /* else `mndx' now ready for use below */
-        zlevel = level_difficulty();
-        /* determine the level of the weakest monster to make. */
-        minmlev = zlevel / 6;
-        /* determine the level of the strongest monster to make. */
-        maxmlev = (zlevel + u.ulevel) / 2;
-        upper = Is_rogue_level(&u.uz);
-        elemlevel = In_endgame(&u.uz) && !Is_astralevel(&u.uz);
+    if (!rndmonst_cur) /* need to recheck the selection criteria */
+        rndmonst_cur = rndmonst_table();
 
-        /*
-         * Find out how many monsters exist in the range we have selected.
-         */
-        for ( ; mndx < SPECIAL_PM; mndx++) { /* (`mndx' initialized above) */
-            ptr = &mons[mndx];
-            rndmonst_state.mchoices[mndx] = 0;
-            if (tooweak(mndx, minmlev) || toostrong(mndx, maxmlev))
-                continue;
-            if (upper && !isupper((uchar) def_monsyms[(int) ptr->mlet].sym))
-                continue;
-            if (elemlevel && wrong_elem_type(ptr))
-                continue;
-            if (uncommon(mndx))
-                continue;
-            if (Inhell && (ptr->geno & G_NOHELL))
-                continue;
-            ct = (int) (ptr->geno & G_FREQ) + align_shift(ptr);
-            if (ct < 0 || ct > 127)
-                panic("rndmonst: bad count [#%d: %d]", mndx, ct);
-            rndmonst_state.choice_count += ct;
-            rndmonst_state.mchoices[mndx] = (char) ct;
-        }
-        /*
-         *      Possible modification:  if choice_count is "too low",
-         *      expand minmlev..maxmlev range and try again.
-         */
-    } /* choice_count+mchoices[] recalc */
-
-    if (rndmonst_state.choice_count <= 0) {
+    ct = rndmonst_cur->cumfreq[SPECIAL_PM - 1];
+    if (ct <= 0) {
         /* maybe no common mons left, or all are too weak or too strong */
-        debugpline1("rndmonst: choice_count=%d", rndmonst_state.choice_count);
+        debugpline1("rndmonst: choice_count=%d", ct);
         return (struct permonst *) 0;
     }
 
     /*
-     *  Now, select a monster at random.
+     *  Now, select a monster at random:  the first one whose running
+     *  total reaches the roll.
      */
-    ct = rnd(rndmonst_state.choice_count);
-    for (mndx = LOW_PM; mndx < SPECIAL_PM; mndx++)
-        if ((ct -= (int) rndmonst_state.mchoices[mndx]) <= 0)
-            break;
+    ct = rnd(ct);
+    for (lo = LOW_PM, hi = SPECIAL_PM - 1; lo < hi;) {
+        mndx = (lo + hi) / 2;
+        if (rndmonst_cur->cumfreq[mndx] < ct)
+            lo = mndx + 1;
+        else
+            hi = mndx;
+    }
+    mndx = lo;
 
-    if (mndx == SPECIAL_PM || uncommon(mndx)) { /* shouldn't happen */
+    if (uncommon(mndx)) { /* shouldn't happen */
         impossible("rndmonst: bad `mndx' [#%d]", mndx);
         return (struct permonst *) 0;
     }
@@ -1578,15 +1628,61 @@ void
 reset_rndmonst(mndx)
 int mndx; /* particular species that can no longer be created */
 {
+    struct rndmonst_tab *tab;
+    int i, j, ct;
+
     /* cached selection info is out of date */
     if (mndx == NON_PM) {
-        rndmonst_state.choice_count = -1; /* full recalc needed */
+        rndmonst_cur = 0; /* recheck criteria on next use */
     } else if (mndx < SPECIAL_PM) {
-        rndmonst_state.choice_count -= rndmonst_state.mchoices[mndx];
-        rndmonst_state.mchoices[mndx] = 0;
+        /* take the species out of every table, not just the current one */
+        for (i = 0; i < RNDMONST_TABLES; i++) {
+            tab = &rndmonst_tabs[i];
+            if (!tab->valid)
+                continue;
+            ct = tab->cumfreq[mndx] - (mndx > LOW_PM ? tab->cumfreq[mndx - 1]
+                                                     : 0);
+            if (ct)
+                for (j = mndx; j < SPECIAL_PM; j++)
+                    tab->cumfreq[j] -= ct;
+        }
     } /* note: safe to ignore extinction of unique monsters */
 }
 
+/* find the run of mons[] entries for a monster class; returns the first
+   index and sets *lastp to one past the last, or returns NON_PM */
+STATIC_OVL int
+mclass_range(class, lastp)
+int class;
+int *lastp;
+{
+    /* class boundaries never change, so look them up once */
+    static NEARDATA short mclass_first[MAXMCLASSES], mclass_last[MAXMCLASSES];
+    static NEARDATA boolean mclass_init = FALSE;
+    int mndx, end, mlet;
+
+    if (!mclass_init) {
+        for (mlet = 0; mlet < MAXMCLASSES; mlet++)
+            mclass_first[mlet] = mclass_last[mlet] = NON_PM;
+        /*  Assumption #1:  monsters of a given class are contiguous in the
+         *                  mons[] array; only the first run is used.
+         */
+        for (mndx = LOW_PM; mndx < SPECIAL_PM; mndx = end) {
+            mlet = mons[mndx].mlet;
+            for (end = mndx + 1; end < SPECIAL_PM && mons[end].mlet == mlet;
+                 end++)
+                continue;
+            if (mclass_first[mlet] == NON_PM) {
+                mclass_first[mlet] = mndx;
+                mclass_last[mlet] = end;
+            }
+        }
+        mclass_init = TRUE;
+    }
+    *lastp = mclass_last[class];
+    return mclass_first[class];
+}
+
 /* decide whether it's ok to generate a candidate monster by mkclass() */
 STATIC_OVL boolean
 mk_gen_ok(mndx, mvflagsmask, genomask)
@@ -1619,23 +1715,17 @@ char class;
 int spc;
 {
     register int first, last, num = 0;
-    int maxmlev, mask = (G_NOGEN | G_UNIQ) & ~spc;
+    int end, maxmlev, mask = (G_NOGEN | G_UNIQ) & ~spc;
 
     maxmlev = level_difficulty() >> 1;
     if (class < 1 || class >= MAXMCLASSES) {
         impossible("mkclass called with bad class!");
         return (struct permonst *) 0;
     }
-    /*  Assumption #1:  monsters of a given class are contiguous in the
-     *                  mons[] array.
-     */
-    for (first = LOW_PM; first < SPECIAL_PM; first++)
-        if (mons[first].mlet == class)
-            break;
-    if (first == SPECIAL_PM)
+    if ((first = mclass_range(class, &end)) == NON_PM)
         return (struct permonst *) 0;
 
-    for (last = first; last < SPECIAL_PM && mons[last].mlet == class; last++)
+    for (last = first; last < end; last++)
         if (mk_gen_ok(last, G_GONE, mask)) {
             /* consider it */
             if (num && toostrong(last, maxmlev)
@@ -1673,14 +1763,13 @@ mkclass_poly(class)
 int class;
 {
     register int first, last, num = 0;
+    int end;
 
-    for (first = LOW_PM; first < SPECIAL_PM; first++)
-        if (mons[first].mlet == class)
-            break;
-    if (first == SPECIAL_PM)
+    if (class < 1 || class >= MAXMCLASSES
+        || (first = mclass_range(class, &end)) == NON_PM)
         return NON_PM;
 
-    for (last = first; last < SPECIAL_PM && mons[last].mlet == class; last++)
+    for (last = first; last < end; last++)
         if (mk_gen_ok(last, G_GENOD, (G_NOGEN | G_UNIQ)))
             num += mons[last].geno & G_FREQ;
     if (!num)
@@ -54,24 +54,52 @@ static int explcolors[] = {
     (currentgraphics == ROGUESET && SYMHANDLING(H_IBM))
 #endif
 
-#define is_objpile(x,y) (!Hallucination && level.objects[(x)][(y)] \
+#define is_objpile(x,y) (isok((x), (y)) && !Hallucination \
+                         && level.objects[(x)][(y)]             \
                          && level.objects[(x)][(y)]->nexthere)
 
-/*ARGSUSED*/
-int
-mapglyph(glyph, ochar, ocolor, ospecial, x, y)
-int glyph, *ocolor, x, y;
-int *ochar;
+/*
+ * Most of what mapglyph() works out depends only on the glyph and on
+ * the current symbol set and color options, so it is kept in a table
+ * indexed by glyph.  The table is rebuilt whenever showsyms[] or one of
+ * the options that affect it changes, and on entering or leaving the
+ * Rogue level.  Object piles and the hero's own location still have to
+ * be looked at for each call.  What has_color() says about the terminal
+ * is assumed not to change once the game is under way.
+ */
+struct glyphmap {
+    short idx;        /* index into showsyms[] */
+    nhsym ch;
+    uchar color;
+    boolean pilable;  /* MG_OBJPILE may apply at a particular spot */
+    unsigned special; /* MG_xxx flags other than MG_OBJPILE */
+};
+
+static struct glyphmap glyphmap[MAX_GLYPH];
+static int glyphmap_mode = -1; /* options the table was built for */
+static unsigned glyphmap_gen;  /* showsyms_gen when the table was built */
+
+static boolean glyphmap_off = FALSE; /* for timing the table against
+                                        doing without it */
+
+STATIC_DCL int FDECL(glyph_render, (int, int *, int *, unsigned *, int,
+                                    int, BOOLEAN_P));
+STATIC_DCL void FDECL(build_glyphmap, (int, BOOLEAN_P));
+
+/*
+ * Work out the symbol, its showsyms[] index, color and special flags
+ * for a glyph.  x < 0 means no particular location, so neither an
+ * object pile nor the hero is assumed to be there.
+ */
+STATIC_OVL int
+glyph_render(glyph, ochar, ocolor, ospecial, x, y, has_rogue_color)
+int glyph, *ochar, *ocolor, x, y;
 unsigned *ospecial;
+boolean has_rogue_color;
 {
     register int offset, idx;
     int color = NO_COLOR;
-    nhsym ch;
     unsigned special = 0;
-    /* condense multiple tests in macro version down to single */
-    boolean has_rogue_ibm_graphics = HAS_ROGUE_IBM_GRAPHICS;
-    boolean has_rogue_color = (has_rogue_ibm_graphics
-                               && symset[currentgraphics].nocolor == 0);
 
     /*
      *  Map the glyph back to a character and color.
@@ -222,14 +250,86 @@ unsigned *ospecial;
         }
     }
 
-    ch = showsyms[idx];
 #ifdef TEXTCOLOR
     /* Turn off color if no color defined, or rogue level w/o PC graphics. */
     if (!has_color(color) || (Is_rogue_level(&u.uz) && !has_rogue_color))
         color = NO_COLOR;
 #endif
 
-    *ochar = (int) ch;
+    *ochar = (int) showsyms[idx];
+    *ocolor = color;
+    *ospecial = special;
+    return idx;
+}
+
+STATIC_OVL void
+build_glyphmap(mode, has_rogue_color)
+int mode;
+boolean has_rogue_color;
+{
+    register int glyph;
+    struct glyphmap *gm;
+    int ch, color;
+    unsigned special;
+
+    for (glyph = 0, gm = glyphmap; glyph < MAX_GLYPH; glyph++, gm++) {
+        gm->idx = (short) glyph_render(glyph, &ch, &color, &special, -1, -1,
+                                       has_rogue_color);
+        gm->ch = (nhsym) ch;
+        gm->color = (uchar) color;
+        gm->special = special;
+        gm->pilable = (glyph_is_object(glyph)
+                       && glyph != objnum_to_glyph(BOULDER));
+    }
+    glyphmap_mode = mode;
+    glyphmap_gen = showsyms_gen;
+}
+
+/*ARGSUSED*/
+int
+mapglyph(glyph, ochar, ocolor, ospecial, x, y)
+int glyph, *ocolor, x, y;
+int *ochar;
+unsigned *ospecial;
+{
+    register struct glyphmap *gm;
+    int idx, ch, color, mode;
+    unsigned special;
+    /* condense multiple tests in macro version down to single */
+    boolean has_rogue_ibm_graphics = HAS_ROGUE_IBM_GRAPHICS;
+    boolean has_rogue_color = (has_rogue_ibm_graphics
+                               && symset[currentgraphics].nocolor == 0);
+
+    if (glyph < 0 || glyph >= MAX_GLYPH || (x == u.ux && y == u.uy)
+        || glyphmap_off) {
+        /* the hero's own symbol can depend on where it is shown */
+        idx = glyph_render(glyph, &ch, &color, &special, x, y,
+                           has_rogue_color);
+    } else {
+        mode = (iflags.use_color ? 1 : 0) | (has_rogue_color ? 2 : 0)
+               | (Is_rogue_level(&u.uz) ? 4 : 0);
+        if (mode != glyphmap_mode || showsyms_gen != glyphmap_gen)
+            build_glyphmap(mode, has_rogue_color);
+        gm = &glyphmap[glyph];
+        idx = gm->idx;
+        ch = (int) gm->ch;
+        color = gm->color;
+        special = gm->special;
+        if (gm->pilable && is_objpile(x, y))
+            special |= MG_OBJPILE;
+        if (iflags.sanity_check) {
+            int chkch, chkcolor;
+            unsigned chkspecial;
+
+            if (glyph_render(glyph, &chkch, &chkcolor, &chkspecial, x, y,
+                             has_rogue_color) != idx
+                || chkch != ch || chkcolor != color || chkspecial != special)
+                impossible("mapglyph: table entry for glyph %d is stale",
+                           glyph);
+        }
+    }
+
+    *ochar = ch;
     *ospecial = special;
 #ifdef TEXTCOLOR
     *ocolor = color;
@@ -237,6 +337,34 @@ unsigned *ospecial;
     return idx;
 }
 
+/* #wizbench: time mapglyph() with and without its table */
+void
+mapglyph_bench(win)
+winid win;
+{
+    char buf[BUFSZ];
+    int i, glyph, ch, color, pass, passes = 1000;
+    unsigned special;
+    long t[2];
+    boolean save_sanity = iflags.sanity_check;
+
+    iflags.sanity_check = FALSE;
+    for (i = 0; i < 2; i++) {
+        glyphmap_off = (i == 1);
+        t[i] = cputime_ms();
+        for (pass = 0; pass < passes; pass++)
+            for (glyph = 0; glyph < MAX_GLYPH; glyph++)
+                (void) mapglyph(glyph, &ch, &color, &special, 1, 1);
+        t[i] = cputime_ms() - t[i];
+    }
+    glyphmap_off = FALSE;
+    iflags.sanity_check = save_sanity;
+
+    Sprintf(buf, "mapglyph: %ld calls, table %ld ms, without %ld ms",
+            (long) passes * MAX_GLYPH, t[0], t[1]);
+    putstr(win, 0, buf);
+}
+
 char *
 encglyph(glyph)
 int glyph;
@@ -596,6 +596,7 @@ clear_level_structures()
              */
             level.objects[x][y] = (struct obj *) 0;
             level.monsters[x][y] = (struct monst *) 0;
+            level.traps[x][y] = (struct trap *) 0;
         }
     }
     level.objlist = (struct obj *) 0;
@@ -981,12 +982,15 @@ void
 mklev()
 {
     struct mkroom *croom;
-    int ridx;
+    int ridx, oldrng;
 
     init_mapseen(&u.uz);
     if (getbones())
         return;
 
+    /* a level is built from its own random number stream */
+    rng_level(ledger_no(&u.uz));
+    oldrng = rng_select(RNG_LEVEL);
     in_mklev = TRUE;
     makelevel();
     bound_digging();
@@ -1010,6 +1014,7 @@ mklev()
        entered; rooms[].orig_rtype always retains original rtype value */
     for (ridx = 0; ridx < SIZE(rooms); ridx++)
         rooms[ridx].orig_rtype = rooms[ridx].rtype;
+    (void) rng_select(oldrng);
 }
 
 void
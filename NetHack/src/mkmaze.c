@@ -1376,6 +1376,8 @@ movebubbles()
 
                             cons->next = b->cons;
                             b->cons = cons;
+
+                            remove_trap_at(x, y);
                         }
 
                         levl[x][y] = water_pos;
@@ -1777,6 +1779,7 @@ boolean ini;
                 struct trap *btrap = (struct trap *) cons->list;
                 btrap->tx = cons->x;
                 btrap->ty = cons->y;
+                place_trap_at(btrap);
                 break;
             }
 
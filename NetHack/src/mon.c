@@ -28,6 +28,8 @@ STATIC_DCL struct permonst *FDECL(accept_newcham_form, (int));
 STATIC_DCL struct obj *FDECL(make_corpse, (struct monst *, unsigned));
 STATIC_DCL void FDECL(m_detach, (struct monst *, struct permonst *));
 STATIC_DCL void FDECL(lifesaved_monster, (struct monst *));
+STATIC_DCL struct mid_entry *FDECL(mid_slot, (unsigned));
+STATIC_DCL void NDECL(mid_index_grow);
 
 #define LEVEL_SPECIFIC_NOCORPSE(mdat) \
     (Is_rogue_level(&u.uz)            \
@@ -102,6 +104,9 @@ mon_sanity_check()
         } else if (mtmp->wormno) {
             sanity_check_worm(mtmp);
         }
+        if (mid_index_find(mtmp->m_id, FM_FMON) != mtmp)
+            impossible("mon (%s) #%u is not indexed by its m_id!",
+                       fmt_ptr((genericptr_t) mtmp), mtmp->m_id);
     }
 
     for (x = 0; x < COLNO; x++)
@@ -125,6 +130,9 @@ mon_sanity_check()
 
     for (mtmp = migrating_mons; mtmp; mtmp = mtmp->nmon) {
         sanity_check_single_mon(mtmp, FALSE, "migr");
+        if (mid_index_find(mtmp->m_id, FM_MIGRATE) != mtmp)
+            impossible("migrating mon (%s) #%u is not indexed by its m_id!",
+                       fmt_ptr((genericptr_t) mtmp), mtmp->m_id);
     }
 }
 
@@ -669,11 +677,65 @@ mcalcdistress()
     }
 }
 
+/*
+ * Monsters which might still act during the current turn, in fmon order.
+ * Movement is only handed out between turns, so after one pass over all
+ * of fmon the later passes of the same turn only need to look at the
+ * monsters which kept enough movement for another action.  A monster
+ * joining fmon (see mid_index_add()) forces the next pass to walk the
+ * whole chain again; one leaving it is dropped from the queue.
+ */
+static struct monst **mready = 0;
+static int mready_n = 0, mready_w = 0, mready_max = 0;
+static boolean mready_ok = FALSE;
+
+/* movement has been handed out or fmon has changed wholesale */
+void
+reset_mready()
+{
+    mready_ok = FALSE;
+}
+
+/* queue mon for the next pass of movemon() */
+STATIC_OVL void
+mready_add(mon)
+struct monst *mon;
+{
+    if (mready_w >= mready_max) {
+        struct monst **oldq = mready;
+
+        mready_max = mready_max ? 2 * mready_max : 64;
+        mready = (struct monst **) alloc(mready_max * sizeof *mready);
+        if (oldq) {
+            (void) memcpy((genericptr_t) mready, (genericptr_t) oldq,
+                          mready_n * sizeof *mready);
+            free((genericptr_t) oldq);
+        }
+    }
+    mready[mready_w++] = mon;
+    if (mready_w > mready_n)
+        mready_n = mready_w;
+}
+
+/* mon is leaving fmon or being freed */
+STATIC_OVL void
+mready_drop(mon)
+struct monst *mon;
+{
+    int i;
+
+    for (i = 0; i < mready_n; i++)
+        if (mready[i] == mon)
+            mready[i] = (struct monst *) 0;
+}
+
 int
 movemon()
 {
     register struct monst *mtmp, *nmtmp;
     register boolean somebody_can_move = FALSE;
+    boolean fullpass = !mready_ok;
+    int i = 0, n = mready_n;
 
     /*
      * Some of you may remember the former assertion here that
@@ -692,9 +754,32 @@ movemon()
      * and drink cursed potions of raise level to change levels.  These are
      * all reflexive at this point.  Should one monster be able to level
      * teleport another, this scheme would have problems.
+     *
+     * Only the first pass after movement has been handed out walks
+     * all of fmon; the others take their monsters from mready[],
+     * which keeps them in the same relative order.
      */
 
-    for (mtmp = fmon; mtmp; mtmp = nmtmp) {
+    mready_w = 0;
+    if (fullpass) {
+        mready_n = 0;
+        mready_ok = TRUE;
+        nmtmp = fmon;
+    } else {
+        nmtmp = (struct monst *) 0;
+    }
+    for (;;) {
+        if (fullpass) {
+            if (!(mtmp = nmtmp))
+                break;
+        } else {
+            while (i < n && !mready[i])
+                i++;
+            if (i >= n)
+                break;
+            mtmp = mready[i];
+            mready[i++] = (struct monst *) 0;
+        }
         /* end monster movement early if hero is flagged to leave the level */
         if (u.utotype
 #ifdef SAFERHANGUP
@@ -703,11 +788,14 @@ movemon()
 #endif
             ) {
             somebody_can_move = FALSE;
+            mready_ok = FALSE; /* rest of the queue wasn't visited */
             break;
         }
         nmtmp = mtmp->nmon;
         /* one dead monster needs to perform a move after death:
            vault guard whose temporary corridor is still on the map */
+        if (mtmp->isgd)
+            mready_add(mtmp);
         if (mtmp->isgd && !mtmp->mx && mtmp->mhp <= 0)
             (void) gd_move(mtmp);
         if (DEADMONSTER(mtmp))
@@ -718,8 +806,11 @@ movemon()
             continue;
 
         mtmp->movement -= NORMAL_SPEED;
-        if (mtmp->movement >= NORMAL_SPEED)
+        if (mtmp->movement >= NORMAL_SPEED) {
             somebody_can_move = TRUE;
+            if (!mtmp->isgd)
+                mready_add(mtmp);
+        }
 
         if (vision_full_recalc)
             vision_recalc(0); /* vision! */
@@ -768,6 +859,7 @@ movemon()
         if (dochugw(mtmp)) /* otherwise just move the monster */
             continue;
     }
+    mready_n = mready_w;
 
     if (any_light_source())
         vision_full_recalc = 1; /* in case a mon moved with a light source */
@@ -1232,6 +1324,108 @@ struct obj *otmp;
     return iquan;
 }
 
+/*
+ * What mfndpos() needs to know about a monster which depends only on its
+ * form.  It is worked out the first time a species is seen and stays
+ * valid however often individual monsters change shape, since the entry
+ * used always follows mon->data.
+ */
+struct mfndpos_caps {
+    unsigned char flags;  /* MFP_xxx */
+    unsigned long traps;  /* bit n: traps of type n can't hurt this form */
+};
+
+#define MFP_KNOWN 0x01    /* entry has been filled in */
+#define MFP_NODIAG 0x02   /* grid bug */
+#define MFP_WANTPOOL 0x04 /* eel; prefers water */
+#define MFP_POOLOK 0x08
+#define MFP_LAVAOK 0x10
+#define MFP_GASOK 0x20    /* doesn't breathe poison gas */
+#define MFP_DOORFLOW 0x40 /* flows under closed doors */
+
+/* only these can satisfy is_pool() or is_lava() */
+#define MAYBE_WET(typ) ((typ) == POOL || (typ) == MOAT || (typ) == WATER \
+                        || (typ) == LAVAPOOL || (typ) == DRAWBRIDGE_UP)
+
+#define TRAPBIT(ttyp) (1UL << (ttyp))
+#define PITTRAPS (TRAPBIT(PIT) | TRAPBIT(SPIKED_PIT) | TRAPBIT(HOLE) \
+                  | TRAPBIT(TRAPDOOR))
+
+static struct mfndpos_caps mfndpos_caps[NUMMONS];
+
+STATIC_DCL struct mfndpos_caps *FDECL(mfndpos_form, (struct permonst *));
+STATIC_DCL void FDECL(mfndpos_dig, (struct monst *, boolean *, boolean *));
+
+STATIC_OVL struct mfndpos_caps *
+mfndpos_form(mdat)
+struct permonst *mdat;
+{
+    struct mfndpos_caps *caps = &mfndpos_caps[monsndx(mdat)];
+    unsigned long traps;
+
+    if (caps->flags & MFP_KNOWN)
+        return caps;
+
+    caps->flags = MFP_KNOWN;
+    if (NODIAG(monsndx(mdat)))
+        caps->flags |= MFP_NODIAG;
+    if (mdat->mlet == S_EEL)
+        caps->flags |= MFP_WANTPOOL;
+    if (is_flyer(mdat) || is_clinger(mdat)
+        || (is_swimmer(mdat) && mdat->mlet != S_EEL))
+        caps->flags |= MFP_POOLOK;
+    if (is_flyer(mdat) || is_clinger(mdat) || likes_lava(mdat))
+        caps->flags |= MFP_LAVAOK;
+    if (nonliving(mdat) || breathless(mdat))
+        caps->flags |= MFP_GASOK;
+    if (amorphous(mdat))
+        caps->flags |= MFP_DOORFLOW;
+
+    /* the form-only parts of the trap test in mfndpos(); pits and holes
+       are put back in Sokoban, and the sleeping gas, fire and magic
+       traps depend on the individual monster */
+    traps = TRAPBIT(STATUE_TRAP);
+    if (mdat != &mons[PM_IRON_GOLEM])
+        traps |= TRAPBIT(RUST_TRAP);
+    if (is_flyer(mdat) || is_floater(mdat) || is_clinger(mdat))
+        traps |= PITTRAPS;
+    if (mdat->msize <= MZ_SMALL || amorphous(mdat) || is_flyer(mdat)
+        || is_floater(mdat) || is_whirly(mdat) || unsolid(mdat))
+        traps |= TRAPBIT(BEAR_TRAP);
+    if (is_flyer(mdat))
+        traps |= TRAPBIT(SQKY_BOARD);
+    if (amorphous(mdat) || webmaker(mdat) || is_whirly(mdat)
+        || unsolid(mdat))
+        traps |= TRAPBIT(WEB);
+    caps->traps = traps;
+    return caps;
+}
+
+/* which digging tools mon can use right now; only looked at once a
+   neighbouring spot needs digging */
+STATIC_OVL void
+mfndpos_dig(mon, rockok, treeok)
+struct monst *mon;
+boolean *rockok, *treeok;
+{
+    struct obj *mw_tmp;
+
+    /* need to be specific about what can currently be dug */
+    if (!needspick(mon->data)) {
+        *rockok = *treeok = TRUE;
+    } else if ((mw_tmp = MON_WEP(mon)) && mw_tmp->cursed
+               && mon->weapon_check == NO_WEAPON_WANTED) {
+        *rockok = is_pick(mw_tmp);
+        *treeok = is_axe(mw_tmp);
+    } else {
+        *rockok = (m_carrying(mon, PICK_AXE)
+                   || (m_carrying(mon, DWARVISH_MATTOCK)
+                       && !which_armor(mon, W_ARMS)));
+        *treeok = (m_carrying(mon, AXE) || (m_carrying(mon, BATTLE_AXE)
+                                            && !which_armor(mon, W_ARMS)));
+    }
+}
+
 /* return number of acceptable neighbour positions */
 int
 mfndpos(mon, poss, info, flag)
@@ -1241,53 +1435,44 @@ long *info;  /* long info[9] */
 long flag;
 {
     struct permonst *mdat = mon->data;
+    struct mfndpos_caps *caps = mfndpos_form(mdat);
     register struct trap *ttmp;
     xchar x, y, nx, ny;
     int cnt = 0;
     uchar ntyp;
     uchar nowtyp;
     boolean wantpool, poolok, lavaok, nodiag;
-    boolean rockok = FALSE, treeok = FALSE, thrudoor;
+    boolean rockok = FALSE, treeok = FALSE, thrudoor, digchecked;
     int maxx, maxy;
-    boolean poisongas_ok, in_poisongas;
+    boolean poisongas_ok, in_poisongas, monseeu, scareable, npool, nlava;
     NhRegion *gas_reg;
     int gas_glyph = cmap_to_glyph(S_poisoncloud);
+    unsigned long harmless;
 
     x = mon->mx;
     y = mon->my;
     nowtyp = levl[x][y].typ;
 
-    nodiag = NODIAG(mdat - mons);
-    wantpool = mdat->mlet == S_EEL;
-    poolok = (is_flyer(mdat) || is_clinger(mdat)
-              || (is_swimmer(mdat) && !wantpool));
-    lavaok = (is_flyer(mdat) || is_clinger(mdat) || likes_lava(mdat));
+    nodiag = (caps->flags & MFP_NODIAG) != 0;
+    wantpool = (caps->flags & MFP_WANTPOOL) != 0;
+    poolok = (caps->flags & MFP_POOLOK) != 0;
+    lavaok = (caps->flags & MFP_LAVAOK) != 0;
     thrudoor = ((flag & (ALLOW_WALL | BUSTDOOR)) != 0L);
-    poisongas_ok = ((nonliving(mdat) || is_vampshifter(mon)
-                     || breathless(mdat)) || resists_poison(mon));
-    in_poisongas = ((gas_reg = visible_region_at(x,y)) != 0
+    /* digging tools are only checked for if a spot needs them */
+    digchecked = !(flag & ALLOW_DIG);
+    poisongas_ok = ((caps->flags & MFP_GASOK) || is_vampshifter(mon)
+                    || resists_poison(mon));
+    in_poisongas = (!poisongas_ok && (gas_reg = visible_region_at(x, y)) != 0
                     && gas_reg->glyph == gas_glyph);
-
-    if (flag & ALLOW_DIG) {
-        struct obj *mw_tmp;
-
-        /* need to be specific about what can currently be dug */
-        if (!needspick(mdat)) {
-            rockok = treeok = TRUE;
-        } else if ((mw_tmp = MON_WEP(mon)) && mw_tmp->cursed
-                   && mon->weapon_check == NO_WEAPON_WANTED) {
-            rockok = is_pick(mw_tmp);
-            treeok = is_axe(mw_tmp);
-        } else {
-            rockok = (m_carrying(mon, PICK_AXE)
-                      || (m_carrying(mon, DWARVISH_MATTOCK)
-                          && !which_armor(mon, W_ARMS)));
-            treeok = (m_carrying(mon, AXE) || (m_carrying(mon, BATTLE_AXE)
-                                               && !which_armor(mon, W_ARMS)));
-        }
-        if (rockok || treeok)
-            thrudoor = TRUE;
-    }
+    harmless = caps->traps;
+    if (Sokoban)
+        harmless &= ~PITTRAPS;
+    if (resists_sleep(mon))
+        harmless |= TRAPBIT(SLP_GAS_TRAP);
+    if (resists_fire(mon))
+        harmless |= TRAPBIT(FIRE_TRAP);
+    monseeu = (mon->mcansee && (!Invis || perceives(mdat)));
+    scareable = !scary_immune(mon);
 
 nexttry: /* eels prefer the water, but if there is no water nearby,
             they will crawl over land */
@@ -1304,6 +1489,12 @@ nexttry: /* eels prefer the water, but if there is no water nearby,
             if (nx == x && ny == y)
                 continue;
             ntyp = levl[nx][ny].typ;
+            if ((IS_ROCK(ntyp) || IS_DOOR(ntyp)) && !digchecked) {
+                mfndpos_dig(mon, &rockok, &treeok);
+                if (rockok || treeok)
+                    thrudoor = TRUE;
+                digchecked = TRUE;
+            }
             if (IS_ROCK(ntyp)
                 && !((flag & ALLOW_WALL) && may_passwall(nx, ny))
                 && !((IS_TREE(ntyp) ? treeok : rockok) && may_dig(nx, ny)))
@@ -1311,10 +1502,11 @@ nexttry: /* eels prefer the water, but if there is no water nearby,
             /* KMH -- Added iron bars */
             if (ntyp == IRONBARS && !(flag & ALLOW_BARS))
                 continue;
-            if (IS_DOOR(ntyp) && !(amorphous(mdat) || can_fog(mon))
+            if (IS_DOOR(ntyp) && !thrudoor
                 && (((levl[nx][ny].doormask & D_CLOSED) && !(flag & OPENDOOR))
                     || ((levl[nx][ny].doormask & D_LOCKED)
-                        && !(flag & UNLOCKDOOR))) && !thrudoor)
+                        && !(flag & UNLOCKDOOR)))
+                && !((caps->flags & MFP_DOORFLOW) || can_fog(mon)))
                 continue;
             /* avoid poison gas? */
             if (!poisongas_ok && !in_poisongas
@@ -1333,11 +1525,14 @@ nexttry: /* eels prefer the water, but if there is no water nearby,
                     || (m_at(x, ny) && m_at(nx, y) && worm_cross(x, y, nx, ny)
                         && !m_at(nx, ny) && (nx != u.ux || ny != u.uy))))
                 continue;
-            if ((is_pool(nx, ny) == wantpool || poolok)
-                && (lavaok || !is_lava(nx, ny))) {
+            if (MAYBE_WET(ntyp)) {
+                npool = is_pool(nx, ny);
+                nlava = is_lava(nx, ny);
+            } else {
+                npool = nlava = FALSE;
+            }
+            if ((npool == wantpool || poolok) && (lavaok || !nlava)) {
                 int dispx, dispy;
-                boolean monseeu = (mon->mcansee
-                                   && (!Invis || perceives(mdat)));
                 boolean checkobj = OBJ_AT(nx, ny);
 
                 /* Displacement also displaces the Elbereth/scare monster,
@@ -1352,7 +1547,7 @@ nexttry: /* eels prefer the water, but if there is no water nearby,
                 }
 
                 info[cnt] = 0;
-                if (onscary(dispx, dispy, mon)) {
+                if (scareable && onscary_spot(dispx, dispy, mon)) {
                     if (!(flag & ALLOW_SSM))
                         continue;
                     info[cnt] |= ALLOW_SSM;
@@ -1432,23 +1627,7 @@ nexttry: /* eels prefer the water, but if there is no water nearby,
                                    ttmp->ttyp);
                             continue;
                     }
-                    if ((ttmp->ttyp != RUST_TRAP
-                         || mdat == &mons[PM_IRON_GOLEM])
-                        && ttmp->ttyp != STATUE_TRAP
-                        && ((ttmp->ttyp != PIT && ttmp->ttyp != SPIKED_PIT
-                             && ttmp->ttyp != TRAPDOOR && ttmp->ttyp != HOLE)
-                            || (!is_flyer(mdat) && !is_floater(mdat)
-                                && !is_clinger(mdat)) || Sokoban)
-                        && (ttmp->ttyp != SLP_GAS_TRAP || !resists_sleep(mon))
-                        && (ttmp->ttyp != BEAR_TRAP
-                            || (mdat->msize > MZ_SMALL && !amorphous(mdat)
-                                && !is_flyer(mdat) && !is_floater(mdat)
-                                && !is_whirly(mdat) && !unsolid(mdat)))
-                        && (ttmp->ttyp != FIRE_TRAP || !resists_fire(mon))
-                        && (ttmp->ttyp != SQKY_BOARD || !is_flyer(mdat))
-                        && (ttmp->ttyp != WEB
-                            || (!amorphous(mdat) && !webmaker(mdat)
-                                && !is_whirly(mdat) && !unsolid(mdat)))
+                    if (!(harmless & TRAPBIT(ttmp->ttyp))
                         && (ttmp->ttyp != ANTI_MAGIC || !resists_magm(mon))) {
                         if (!(flag & ALLOW_TRAPS)) {
                             if (mon->mtrapseen & (1L << (ttmp->ttyp - 1)))
@@ -1469,6 +1648,48 @@ nexttry: /* eels prefer the water, but if there is no water nearby,
     return cnt;
 }
 
+/* #wizbench: time mfndpos() for the monsters on this level */
+void
+mfndpos_bench(win)
+winid win;
+{
+    char buf[BUFSZ];
+    struct monst *mtmp;
+    coord poss[9];
+    long info[9], flag, i, n = 1000000L, t, tot = 0L;
+    xchar mux, muy;
+
+    for (mtmp = fmon; mtmp; mtmp = mtmp->nmon)
+        if (!DEADMONSTER(mtmp))
+            break;
+    if (!mtmp) {
+        putstr(win, 0, "mfndpos: no monsters");
+        return;
+    }
+    t = cputime_ms();
+    for (i = 0; i < n; i++) {
+        for (; mtmp; mtmp = mtmp->nmon)
+            if (!DEADMONSTER(mtmp))
+                break;
+        if (!mtmp) {
+            for (mtmp = fmon; DEADMONSTER(mtmp); mtmp = mtmp->nmon)
+                continue;
+        }
+        flag = ALLOW_U | OPENDOOR;
+        if (tunnels(mtmp->data))
+            flag |= ALLOW_DIG;
+        /* mfndpos() may note that the hero is right next to it */
+        mux = mtmp->mux, muy = mtmp->muy;
+        tot += mfndpos(mtmp, poss, info, flag);
+        mtmp->mux = mux, mtmp->muy = muy;
+        mtmp = mtmp->nmon;
+    }
+    t = cputime_ms() - t;
+    Sprintf(buf, "mfndpos: %ld calls (%ld spots), %ld ms, %ld calls/s", n,
+            tot, t, t ? n * 1000L / t : 0L);
+    putstr(win, 0, buf);
+}
+
 /* Monster against monster special attacks; for the specified monster
    combinations, this allows one monster to attack another adjacent one
    in the absence of Conflict.  There is no provision for targetting
@@ -1583,6 +1804,7 @@ struct monst *mtmp, *mtmp2;
     }
     mtmp2->nmon = fmon;
     fmon = mtmp2;
+    mid_index_add(mtmp2, FM_FMON);
     if (u.ustuck == mtmp)
         u.ustuck = mtmp2;
     if (u.usteed == mtmp)
@@ -1607,6 +1829,7 @@ struct monst **monst_list; /* &migrating_mons or &mydogs or null */
 
     if (!fmon)
         panic("relmon: no fmon available.");
+    mready_drop(mon);
 
     if (unhide) {
         /* can't remain hidden across level changes (exception: wizard
@@ -1640,12 +1863,130 @@ struct monst **monst_list; /* &migrating_mons or &mydogs or null */
         /* insert into mydogs or migrating_mons */
         mon->nmon = *monst_list;
         *monst_list = mon;
+        mid_index_add(mon, (monst_list == &mydogs) ? FM_MYDOGS : FM_MIGRATE);
     } else {
         /* orphan has no next monster */
         mon->nmon = 0;
+        mid_index_del(mon);
     }
 }
 
+/*
+ * m_id -> monster index for find_mid().  Every monster on fmon,
+ * migrating_mons or mydogs has an entry recording which of those
+ * chains it's on (as an FM_xxx flag).  Open addressing with linear
+ * probing; deletion shifts later members of the cluster back so that
+ * no tombstones are needed.
+ */
+struct mid_entry {
+    unsigned m_id;
+    unsigned where; /* FM_FMON, FM_MIGRATE or FM_MYDOGS */
+    struct monst *mon; /* null when slot is empty */
+};
+
+static struct mid_entry *mid_index = 0;
+static unsigned mid_index_size = 0, mid_index_count = 0;
+
+#define MID_HASH(id) (((id) * 2654435761U) & (mid_index_size - 1))
+
+/* slot holding m_id, or the empty slot where it would go */
+STATIC_OVL struct mid_entry *
+mid_slot(m_id)
+unsigned m_id;
+{
+    unsigned i = MID_HASH(m_id);
+
+    while (mid_index[i].mon && mid_index[i].m_id != m_id)
+        i = (i + 1) & (mid_index_size - 1);
+    return &mid_index[i];
+}
+
+STATIC_OVL void
+mid_index_grow()
+{
+    struct mid_entry *oldindex = mid_index;
+    unsigned i, oldsize = mid_index_size;
+
+    mid_index_size = oldsize ? 2 * oldsize : 256;
+    mid_index = (struct mid_entry *) alloc(mid_index_size * sizeof *mid_index);
+    (void) memset((genericptr_t) mid_index, 0,
+                  mid_index_size * sizeof *mid_index);
+    for (i = 0; i < oldsize; i++)
+        if (oldindex[i].mon)
+            *mid_slot(oldindex[i].m_id) = oldindex[i];
+    if (oldindex)
+        free((genericptr_t) oldindex);
+}
+
+/* record that mon is on the monster chain designated by `where';
+   a later monster with the same m_id (revival from a corpse while
+   the original is still awaiting dmonsfree()) supersedes the old one */
+void
+mid_index_add(mon, where)
+struct monst *mon;
+unsigned where;
+{
+    struct mid_entry *slot;
+
+    if (2 * (mid_index_count + 1) > mid_index_size)
+        mid_index_grow();
+    slot = mid_slot(mon->m_id);
+    if (!slot->mon)
+        ++mid_index_count;
+    slot->m_id = mon->m_id;
+    slot->where = where;
+    slot->mon = mon;
+    /* a newcomer to fmon hasn't been seen by movemon()'s queue */
+    if (where == FM_FMON)
+        reset_mready();
+}
+
+/* forget mon; harmless if it isn't indexed (monster trait copies
+   attached to corpses and statues are never added) */
+void
+mid_index_del(mon)
+struct monst *mon;
+{
+    struct mid_entry *slot;
+    unsigned i, j, h;
+
+    if (!mid_index_count)
+        return;
+    slot = mid_slot(mon->m_id);
+    if (slot->mon != mon)
+        return;
+    slot->mon = (struct monst *) 0;
+    --mid_index_count;
+    /* close the gap so that later members of the cluster stay reachable */
+    i = (unsigned) (slot - mid_index);
+    for (j = (i + 1) & (mid_index_size - 1); mid_index[j].mon;
+         j = (j + 1) & (mid_index_size - 1)) {
+        h = MID_HASH(mid_index[j].m_id);
+        /* entry j can move to i unless its home lies cyclically in (i,j] */
+        if ((j > i) ? (h <= i || h > j) : (h <= i && h > j)) {
+            mid_index[i] = mid_index[j];
+            mid_index[j].mon = (struct monst *) 0;
+            i = j;
+        }
+    }
+}
+
+/* find_mid() without walking the chains */
+struct monst *
+mid_index_find(m_id, fmflags)
+unsigned m_id, fmflags;
+{
+    struct mid_entry *slot;
+
+    if (!mid_index_count)
+        return (struct monst *) 0;
+    slot = mid_slot(m_id);
+    if (!slot->mon || !(slot->where & fmflags)
+        || (slot->where == FM_FMON && DEADMONSTER(slot->mon)))
+        return (struct monst *) 0;
+    return slot->mon;
+}
+
 void
 copy_mextra(mtmp2, mtmp1)
 struct monst *mtmp2, *mtmp1;
@@ -1720,6 +2061,8 @@ struct monst *mon;
 {
     if (mon->nmon)
         panic("dealloc_monst with nmon");
+    mready_drop(mon);
+    mid_index_del(mon);
     if (mon->mextra)
         dealloc_mextra(mon);
     free((genericptr_t) mon);
@@ -2189,7 +2532,7 @@ struct monst *mtmp;
             if (Punished && uchain->where != OBJ_FLOOR)
                 placebc();
             vision_full_recalc = 1;
-            docrt();
+            refresh_map();
             /* prevent swallower (mtmp might have just poly'd into something
                without an engulf attack) from immediately re-engulfing */
             if (attacktype(mtmp->data, AT_ENGL) && !mtmp->mspec_used)
@@ -2638,7 +2981,7 @@ setmangry(mtmp, via_attack)
 struct monst *mtmp;
 boolean via_attack;
 {
-    if (via_attack && sengr_at("Elbereth", u.ux, u.uy, TRUE)) {
+    if (via_attack && engr_elbereth_at(u.ux, u.uy)) {
         You_feel("像是一个伪君子.");
         /* AIS: Yes, I know alignment penalties and bonuses aren't balanced
            at the moment. This is about correct relative to other "small"
@@ -14,6 +14,9 @@ STATIC_DCL int FDECL(disturb, (struct monst *));
 STATIC_DCL void FDECL(release_hero, (struct monst *));
 STATIC_DCL void FDECL(distfleeck, (struct monst *, int *, int *, int *));
 STATIC_DCL int FDECL(m_arrival, (struct monst *));
+STATIC_DCL boolean FDECL(mon_dormant, (struct monst *));
+STATIC_DCL int FDECL(m_approach, (struct monst *, xchar *, xchar *));
+STATIC_DCL void FDECL(dormant_move, (struct monst *));
 STATIC_DCL boolean FDECL(stuff_prevents_passage, (struct monst *));
 STATIC_DCL int FDECL(vamp_shift, (struct monst *, struct permonst *, BOOLEAN_P));
 
@@ -135,15 +138,30 @@ onscary(x, y, mtmp)
 int x, y;
 struct monst *mtmp;
 {
-    /* creatures who are directly resistant to magical scaring:
-     * Rodney, lawful minions, Angels, the Riders, shopkeepers
-     * inside their own shop, priests inside their own temple */
-    if (mtmp->iswiz || is_lminion(mtmp) || mtmp->data == &mons[PM_ANGEL]
-        || is_rider(mtmp->data)
-        || (mtmp->isshk && inhishop(mtmp))
-        || (mtmp->ispriest && inhistemple(mtmp)))
-        return FALSE;
+    return (boolean) (!scary_immune(mtmp) && onscary_spot(x, y, mtmp));
+}
+
+/* creatures who are directly resistant to magical scaring:
+ * Rodney, lawful minions, Angels, the Riders, shopkeepers
+ * inside their own shop, priests inside their own temple */
+boolean
+scary_immune(mtmp)
+struct monst *mtmp;
+{
+    return (boolean) (mtmp->iswiz || is_lminion(mtmp)
+                      || mtmp->data == &mons[PM_ANGEL]
+                      || is_rider(mtmp->data)
+                      || (mtmp->isshk && inhishop(mtmp))
+                      || (mtmp->ispriest && inhistemple(mtmp)));
+}
 
+/* the rest of onscary(), for callers which have already checked
+   scary_immune() */
+boolean
+onscary_spot(x, y, mtmp)
+int x, y;
+struct monst *mtmp;
+{
     /* <0,0> is used by musical scaring to check for the above;
      * it doesn't care about scrolls or engravings or dungeon branch */
     if (x == 0 && y == 0)
@@ -171,7 +189,7 @@ struct monst *mtmp;
      * Elbereth doesn't work in Gehennom, the Elemental Planes, or the
      * Astral Plane; the influence of the Valar only reaches so far.
      */
-    return (sengr_at("Elbereth", x, y, TRUE)
+    return (engr_elbereth_at(x, y)
             && ((u.ux == x && u.uy == y)
                 || (Displaced && mtmp->mux == x && mtmp->muy == y))
             && !(mtmp->isshk || mtmp->isgd || !mtmp->mcansee
@@ -180,7 +198,6 @@ struct monst *mtmp;
                  || Inhell || In_endgame(&u.uz)));
 }
 
-
 /* regenerate lost hit points */
 void
 mon_regen(mon, digest_meal)
@@ -345,6 +362,181 @@ struct monst *mon;
     return -1;
 }
 
+/* monsters at least this far from the hero which can't see the hero's
+   spot may be dormant; beyond BOLT_LIM so nothing can be lined up */
+#define DORMANT_DIST (2 * BOLT_LIM)
+
+/*
+ * Is mtmp far enough away and unaware enough of the hero that dochug()
+ * can skip the full AI (set_apparxy(), distfleeck(), the defensive and
+ * miscellaneous item checks, m_move()'s object searches and mfndpos())
+ * and just take a cheap step?  Monsters with special duties or special
+ * movement code always get the full treatment, as does every monster
+ * when the wizard-mode option `precise_ai' is set.
+ */
+STATIC_OVL boolean
+mon_dormant(mtmp)
+struct monst *mtmp;
+{
+    struct permonst *ptr = mtmp->data;
+
+    if (wizard && iflags.precise_ai)
+        return FALSE;
+    if (distu(mtmp->mx, mtmp->my) <= DORMANT_DIST * DORMANT_DIST
+        || couldsee(mtmp->mx, mtmp->my) || u.uswallow)
+        return FALSE;
+    if (mtmp->mtame || mtmp->isshk || mtmp->isgd || mtmp->ispriest
+        || mtmp->isminion || mtmp->iswiz || mtmp->wormno || mtmp->mstrategy
+        || mtmp->mtrapped || mtmp->mundetected || mtmp->m_ap_type
+        || mtmp == u.ustuck || mtmp == u.usteed)
+        return FALSE;
+    if ((ptr->geno & G_UNIQ) || is_covetous(ptr) || is_watch(ptr)
+        || is_mind_flayer(ptr) || is_hider(ptr) || hides_under(ptr)
+        || ptr->mlet == S_EEL || is_unicorn(ptr) || !ptr->mmove)
+        return FALSE;
+    /* m_move() would have it follow the hero's trail */
+    if (can_track(ptr) && gettrack(mtmp->mx, mtmp->my))
+        return FALSE;
+    return TRUE;
+}
+
+/* Whether mtmp heads toward (1), away from (-1) or aimlessly around (0)
+ * its goal *gx,*gy; a tracker that can't see the hero may switch its goal
+ * to a spot on the hero's trail.  Shared by m_move() and dormant_move().
+ */
+STATIC_OVL int
+m_approach(mtmp, gx, gy)
+struct monst *mtmp;
+xchar *gx, *gy;
+{
+    struct permonst *ptr = mtmp->data;
+    int omx = mtmp->mx, omy = mtmp->my;
+    int appr = mtmp->mflee ? -1 : 1;
+
+    if (mtmp->mconf || (u.uswallow && mtmp == u.ustuck)) {
+        appr = 0;
+    } else {
+        struct obj *lepgold, *ygold;
+        boolean should_see = (couldsee(omx, omy)
+                              && (levl[*gx][*gy].lit || !levl[omx][omy].lit)
+                              && (dist2(omx, omy, *gx, *gy) <= 36));
+
+        if (!mtmp->mcansee
+            || (should_see && Invis && !perceives(ptr) && rn2(11))
+            || is_obj_mappear(&youmonst,STRANGE_OBJECT) || u.uundetected
+            || (is_obj_mappear(&youmonst,GOLD_PIECE) && !likes_gold(ptr))
+            || (mtmp->mpeaceful && !mtmp->isshk) /* allow shks to follow */
+            || ((monsndx(ptr) == PM_STALKER || ptr->mlet == S_BAT
+                 || ptr->mlet == S_LIGHT) && !rn2(3)))
+            appr = 0;
+
+        if (monsndx(ptr) == PM_LEPRECHAUN && (appr == 1)
+            && ((lepgold = findgold(mtmp->minvent))
+                && (lepgold->quan
+                    > ((ygold = findgold(invent)) ? ygold->quan : 0L))))
+            appr = -1;
+
+        if (!should_see && can_track(ptr)) {
+            register coord *cp;
+
+            cp = gettrack(omx, omy);
+            if (cp) {
+                *gx = cp->x;
+                *gy = cp->y;
+            }
+        }
+    }
+    return appr;
+}
+
+/*
+ * Cheap stand-in for m_move() for a dormant monster:  choose among the
+ * neighbouring spots the way m_move() does, with the same approach rules
+ * (m_approach()) and the same reluctance to retrace its own track, then
+ * step there; stay put if there's nowhere to go.  Only ordinary floor is
+ * considered, so no traps, closed doors, digging or item handling need
+ * to be dealt with; poison gas is avoided the way mfndpos() does it.
+ */
+STATIC_OVL void
+dormant_move(mtmp)
+struct monst *mtmp;
+{
+    int i, j, nx, ny, ndist, nidist, appr, jcnt, cnt = 0;
+    int omx = mtmp->mx, omy = mtmp->my, nix = omx, niy = omy;
+    xchar gx = u.ux, gy = u.uy, chcnt = 0;
+    boolean mmoved = FALSE, nodiag = NODIAG(monsndx(mtmp->data));
+    boolean poisongas_ok, in_poisongas;
+    struct rm *here = &levl[omx][omy];
+    coord poss[8], *mtrk;
+    NhRegion *gas_reg;
+    int gas_glyph = cmap_to_glyph(S_poisoncloud);
+
+    appr = m_approach(mtmp, &gx, &gy);
+    /* same poison gas avoidance as mfndpos() */
+    poisongas_ok = (nonliving(mtmp->data) || breathless(mtmp->data)
+                    || is_vampshifter(mtmp) || resists_poison(mtmp));
+    in_poisongas = (!poisongas_ok
+                    && (gas_reg = visible_region_at(omx, omy)) != 0
+                    && gas_reg->glyph == gas_glyph);
+
+    for (i = 0; i < 8; i++) {
+        nx = omx + xdir[i], ny = omy + ydir[i];
+        if (!goodpos(nx, ny, mtmp, 0) || t_at(nx, ny)
+            || onscary(nx, ny, mtmp)
+            || in_your_sanctuary((struct monst *) 0, nx, ny))
+            continue;
+        if (!poisongas_ok && !in_poisongas
+            && (gas_reg = visible_region_at(nx, ny)) != 0
+            && gas_reg->glyph == gas_glyph)
+            continue;
+        if (nx != omx && ny != omy
+            && (nodiag
+                || (IS_DOOR(here->typ) && (here->doormask & ~D_BROKEN))
+                || (IS_DOOR(levl[nx][ny].typ)
+                    && (levl[nx][ny].doormask & ~D_BROKEN))
+                || ((IS_DOOR(here->typ) || IS_DOOR(levl[nx][ny].typ))
+                    && Is_rogue_level(&u.uz))))
+            continue;
+        poss[cnt].x = nx, poss[cnt].y = ny;
+        cnt++;
+    }
+
+    jcnt = min(MTSZ, cnt - 1);
+    nidist = dist2(nix, niy, gx, gy);
+    for (i = 0; i < cnt; i++) {
+        nx = poss[i].x;
+        ny = poss[i].y;
+        if (appr != 0) {
+            mtrk = &mtmp->mtrack[0];
+            for (j = 0; j < jcnt; mtrk++, j++)
+                if (nx == mtrk->x && ny == mtrk->y)
+                    if (rn2(4 * (cnt - j)))
+                        goto nxti;
+        }
+        ndist = dist2(nx, ny, gx, gy);
+        if ((appr == 1 && ndist < nidist) || (appr == -1 && ndist >= nidist)
+            || (!appr && !rn2(++chcnt)) || !mmoved) {
+            nix = nx;
+            niy = ny;
+            nidist = ndist;
+            mmoved = TRUE;
+        }
+    nxti:
+        ;
+    }
+    if (!mmoved || !m_in_out_region(mtmp, nix, niy))
+        return;
+
+    remove_monster(omx, omy);
+    place_monster(mtmp, nix, niy);
+    for (j = MTSZ - 1; j > 0; j--)
+        mtmp->mtrack[j] = mtmp->mtrack[j - 1];
+    mtmp->mtrack[0].x = omx;
+    mtmp->mtrack[0].y = omy;
+    newsym(omx, omy);
+    newsym(nix, niy);
+}
+
 /* returns 1 if monster died moving, 0 otherwise */
 /* The whole dochugw/m_move/distfleeck/mfndpos section is serious spaghetti
  * code. --KAA
@@ -427,6 +619,12 @@ register struct monst *mtmp;
         return 0; /* uses up monster's turn */
     }
 
+    /* far away and unaware of the hero; skip the expensive parts */
+    if (mon_dormant(mtmp)) {
+        dormant_move(mtmp);
+        return 0;
+    }
+
     set_apparxy(mtmp);
     /* Must be done after you move and before the monster does.  The
      * set_apparxy() call in m_move() doesn't suffice since the variables
@@ -887,40 +1085,7 @@ not_special:
     omy = mtmp->my;
     gx = mtmp->mux;
     gy = mtmp->muy;
-    appr = mtmp->mflee ? -1 : 1;
-    if (mtmp->mconf || (u.uswallow && mtmp == u.ustuck)) {
-        appr = 0;
-    } else {
-        struct obj *lepgold, *ygold;
-        boolean should_see = (couldsee(omx, omy)
-                              && (levl[gx][gy].lit || !levl[omx][omy].lit)
-                              && (dist2(omx, omy, gx, gy) <= 36));
-
-        if (!mtmp->mcansee
-            || (should_see && Invis && !perceives(ptr) && rn2(11))
-            || is_obj_mappear(&youmonst,STRANGE_OBJECT) || u.uundetected
-            || (is_obj_mappear(&youmonst,GOLD_PIECE) && !likes_gold(ptr))
-            || (mtmp->mpeaceful && !mtmp->isshk) /* allow shks to follow */
-            || ((monsndx(ptr) == PM_STALKER || ptr->mlet == S_BAT
-                 || ptr->mlet == S_LIGHT) && !rn2(3)))
-            appr = 0;
-
-        if (monsndx(ptr) == PM_LEPRECHAUN && (appr == 1)
-            && ((lepgold = findgold(mtmp->minvent))
-                && (lepgold->quan
-                    > ((ygold = findgold(invent)) ? ygold->quan : 0L))))
-            appr = -1;
-
-        if (!should_see && can_track(ptr)) {
-            register coord *cp;
-
-            cp = gettrack(omx, omy);
-            if (cp) {
-                gx = cp->x;
-                gy = cp->y;
-            }
-        }
-    }
+    appr = m_approach(mtmp, &gx, &gy);
 
     if ((!mtmp->mpeaceful || !rn2(10)) && (!Is_rogue_level(&u.uz))) {
         boolean in_line = (lined_up(mtmp)
@@ -1983,7 +1983,7 @@ struct monst *mtmp;
     display_self();
     You_feel("对%s恼火.", noit_mon_nam(mtmp));
     display_nhwindow(WIN_MAP, TRUE);
-    docrt();
+    refresh_map();
     if (unconscious()) {
         multi = -1;
         nomovemsg = "因为恼火, 你猛然醒为全意识.";
@@ -145,6 +145,9 @@ static struct Bool_Opt {
     { "legacy", &flags.legacy, TRUE, DISP_IN_GAME },
     { "lit_corridor", &flags.lit_corridor, FALSE, SET_IN_GAME },
     { "lootabc", &flags.lootabc, FALSE, SET_IN_GAME },
+#ifdef LZCOMP
+    { "lzcomp", &iflags.lzcomp, FALSE, DISP_IN_GAME },
+#endif
 #ifdef MAIL
     { "mail", &flags.biff, TRUE, SET_IN_GAME },
 #else
@@ -177,6 +180,7 @@ static struct Bool_Opt {
     { "pickup_thrown", &flags.pickup_thrown, TRUE, SET_IN_GAME },
     { "popup_dialog", &iflags.wc_popup_dialog, TRUE, SET_IN_GAME },   /*WC*/
     { "preload_tiles", &iflags.wc_preload_tiles, TRUE, DISP_IN_GAME }, /*WC*/
+    { "precise_ai", &iflags.precise_ai, FALSE, SET_IN_WIZGAME },
     { "pushweapon", &flags.pushweapon, FALSE, SET_IN_GAME },
 #if defined(MICRO) && !defined(AMIGA)
     { "rawio", &iflags.rawio, FALSE, DISP_IN_GAME },
@@ -583,6 +587,7 @@ reglyph_darkroom()
         showsyms[S_darkroom] = showsyms[S_room];
     else
         showsyms[S_darkroom] = showsyms[S_stone];
+    showsyms_gen++;
 }
 
 /* check whether a user-supplied option string is a proper leading
@@ -3723,6 +3728,10 @@ boolean tinitial, tfrom_file;
 #ifdef ZEROCOMP
             if (boolopt[i].addr == &iflags.zerocomp)
                 set_savepref(iflags.zerocomp ? "zerocomp" : "externalcomp");
+#endif
+#ifdef LZCOMP
+            if (boolopt[i].addr == &iflags.lzcomp)
+                set_savepref(iflags.lzcomp ? "lzcomp" : "externalcomp");
 #endif
             if (boolopt[i].addr == &iflags.wc_ascii_map) {
                 /* toggling ascii_map; set tiled_map to its opposite;
@@ -5817,6 +5826,8 @@ option_help()
                 continue;
             if (boolopt[i].addr == &iflags.menu_tab_sep && !wizard)
                 continue;
+            if (boolopt[i].addr == &iflags.precise_ai && !wizard)
+                continue;
             next_opt(datawin, boolopt[i].name);
         }
     }
@@ -917,7 +917,7 @@ int howmuch;
      * thing to do is to run it through the vision system again, which
      * is always correct.
      */
-    docrt(); /* this correctly will reset vision */
+    refresh_map(); /* this correctly will reset vision */
 }
 
 /* monster is hit by scroll of taming's effect */
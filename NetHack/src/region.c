@@ -15,6 +15,17 @@ static NhRegion **regions;
 static int n_regions = 0;
 static int max_regions = 0;
 
+/*
+ * Number of active regions covering each map location, and how many of
+ * those are visible.  Most spots aren't under any region, so point
+ * queries check these first and only scan regions[] when they're set.
+ */
+static unsigned short region_cnt[COLNO][ROWNO];
+static unsigned short vregion_cnt[COLNO][ROWNO];
+
+/* inside_region() for a location known to be on the map */
+#define reg_covers(reg, x, y) (region_cnt[x][y] && inside_region(reg, x, y))
+
 #define NO_CALLBACK (-1)
 
 boolean FDECL(inside_gas_cloud, (genericptr, genericptr));
@@ -44,6 +55,7 @@ NhRegion *FDECL(create_force_field, (XCHAR_P,XCHAR_P,int,long));
 #endif
 
 STATIC_DCL void FDECL(reset_region_mids, (NhRegion *));
+STATIC_DCL void FDECL(count_region, (NhRegion *, int));
 
 static callback_proc callbacks[] = {
 #define INSIDE_GAS_CLOUD 0
@@ -307,6 +319,7 @@ NhRegion *reg;
     }
     regions[n_regions] = reg;
     n_regions++;
+    count_region(reg, 1);
     /* Check for monsters inside the region */
     for (i = reg->bounding_box.lx; i <= reg->bounding_box.hx; i++)
         for (j = reg->bounding_box.ly; j <= reg->bounding_box.hy; j++) {
@@ -342,6 +355,7 @@ NhRegion *reg;
 
     /* Update screen if necessary */
     reg->ttl = -2L; /* for visible_region_at */
+    count_region(reg, -1);
     if (reg->visible)
         for (x = reg->bounding_box.lx; x <= reg->bounding_box.hx; x++)
             for (y = reg->bounding_box.ly; y <= reg->bounding_box.hy; y++)
@@ -370,6 +384,30 @@ clear_regions()
         free((genericptr_t) regions);
     max_regions = 0;
     regions = (NhRegion **) 0;
+    (void) memset((genericptr_t) region_cnt, 0, sizeof region_cnt);
+    (void) memset((genericptr_t) vregion_cnt, 0, sizeof vregion_cnt);
+}
+
+/*
+ * Add (delta 1) or take away (delta -1) a region's coverage in the
+ * per-location counts.
+ */
+STATIC_OVL void
+count_region(reg, delta)
+NhRegion *reg;
+int delta;
+{
+    int x, y;
+
+    for (x = max(reg->bounding_box.lx, 1);
+         x <= min(reg->bounding_box.hx, COLNO - 1); x++)
+        for (y = max(reg->bounding_box.ly, 0);
+             y <= min(reg->bounding_box.hy, ROWNO - 1); y++)
+            if (inside_region(reg, x, y)) {
+                region_cnt[x][y] += delta;
+                if (reg->visible)
+                    vregion_cnt[x][y] += delta;
+            }
 }
 
 /*
@@ -432,12 +470,12 @@ xchar x, y;
 
     /* First check if we can do the move */
     for (i = 0; i < n_regions; i++) {
-        if (inside_region(regions[i], x, y) && !hero_inside(regions[i])
+        if (reg_covers(regions[i], x, y) && !hero_inside(regions[i])
             && !regions[i]->attach_2_u) {
             if ((f_indx = regions[i]->can_enter_f) != NO_CALLBACK)
                 if (!(*callbacks[f_indx])(regions[i], (genericptr_t) 0))
                     return FALSE;
-        } else if (hero_inside(regions[i]) && !inside_region(regions[i], x, y)
+        } else if (hero_inside(regions[i]) && !reg_covers(regions[i], x, y)
                    && !regions[i]->attach_2_u) {
             if ((f_indx = regions[i]->can_leave_f) != NO_CALLBACK)
                 if (!(*callbacks[f_indx])(regions[i], (genericptr_t) 0))
@@ -448,7 +486,7 @@ xchar x, y;
     /* Callbacks for the regions we do leave */
     for (i = 0; i < n_regions; i++)
         if (hero_inside(regions[i]) && !regions[i]->attach_2_u
-            && !inside_region(regions[i], x, y)) {
+            && !reg_covers(regions[i], x, y)) {
             clear_hero_inside(regions[i]);
             if (regions[i]->leave_msg != (const char *) 0)
                 pline1(regions[i]->leave_msg);
@@ -459,7 +497,7 @@ xchar x, y;
     /* Callbacks for the regions we do enter */
     for (i = 0; i < n_regions; i++)
         if (!hero_inside(regions[i]) && !regions[i]->attach_2_u
-            && inside_region(regions[i], x, y)) {
+            && reg_covers(regions[i], x, y)) {
             set_hero_inside(regions[i]);
             if (regions[i]->enter_msg != (const char *) 0)
                 pline1(regions[i]->enter_msg);
@@ -481,13 +519,13 @@ xchar x, y;
 
     /* First check if we can do the move */
     for (i = 0; i < n_regions; i++) {
-        if (inside_region(regions[i], x, y) && !mon_in_region(regions[i], mon)
+        if (reg_covers(regions[i], x, y) && !mon_in_region(regions[i], mon)
             && regions[i]->attach_2_m != mon->m_id) {
             if ((f_indx = regions[i]->can_enter_f) != NO_CALLBACK)
                 if (!(*callbacks[f_indx])(regions[i], mon))
                     return FALSE;
         } else if (mon_in_region(regions[i], mon)
-                   && !inside_region(regions[i], x, y)
+                   && !reg_covers(regions[i], x, y)
                    && regions[i]->attach_2_m != mon->m_id) {
             if ((f_indx = regions[i]->can_leave_f) != NO_CALLBACK)
                 if (!(*callbacks[f_indx])(regions[i], mon))
@@ -499,7 +537,7 @@ xchar x, y;
     for (i = 0; i < n_regions; i++)
         if (mon_in_region(regions[i], mon)
             && regions[i]->attach_2_m != mon->m_id
-            && !inside_region(regions[i], x, y)) {
+            && !reg_covers(regions[i], x, y)) {
             remove_mon_from_reg(regions[i], mon);
             if ((f_indx = regions[i]->leave_f) != NO_CALLBACK)
                 (void) (*callbacks[f_indx])(regions[i], mon);
@@ -508,7 +546,7 @@ xchar x, y;
     /* Callbacks for the regions we do enter */
     for (i = 0; i < n_regions; i++)
         if (!hero_inside(regions[i]) && !regions[i]->attach_2_u
-            && inside_region(regions[i], x, y)) {
+            && reg_covers(regions[i], x, y)) {
             add_mon_to_reg(regions[i], mon);
             if ((f_indx = regions[i]->enter_f) != NO_CALLBACK)
                 (void) (*callbacks[f_indx])(regions[i], mon);
@@ -598,6 +636,8 @@ xchar x, y;
 {
     register int i;
 
+    if (!isok(x, y) || !vregion_cnt[x][y])
+        return (NhRegion *) 0;
     for (i = 0; i < n_regions; i++)
         if (inside_region(regions[i], x, y) && regions[i]->visible
             && regions[i]->ttl != -2L)
@@ -754,6 +794,8 @@ boolean ghostly; /* If a bones file restore */
         mread(fd, (genericptr_t) &regions[i]->glyph, sizeof(int));
         mread(fd, (genericptr_t) &regions[i]->arg, sizeof(anything));
     }
+    for (i = 0; i < n_regions; i++)
+        count_region(regions[i], 1);
     /* remove expired regions, do not trigger the expire_f callback (yet!);
        also update monster lists if this data is coming from a bones file */
     for (i = n_regions - 1; i >= 0; i--)
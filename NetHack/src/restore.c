@@ -21,9 +21,17 @@ STATIC_DCL void NDECL(zerocomp_minit);
 STATIC_DCL void FDECL(zerocomp_mread, (int, genericptr_t, unsigned int));
 STATIC_DCL int NDECL(zerocomp_mgetc);
 #endif
+#ifdef LZCOMP
+STATIC_DCL void NDECL(lzcomp_minit);
+STATIC_DCL void FDECL(lzcomp_mread, (int, genericptr_t, unsigned int));
+STATIC_DCL boolean FDECL(lz_readblock, (int));
+STATIC_DCL boolean FDECL(lz_unpack, (const unsigned char *, unsigned,
+                                     unsigned char *, unsigned));
+#endif
 
 STATIC_DCL void NDECL(def_minit);
 STATIC_DCL void FDECL(def_mread, (int, genericptr_t, unsigned int));
+STATIC_DCL int FDECL(rawread, (int, genericptr_t, unsigned int));
 
 STATIC_DCL void NDECL(find_lev_obj);
 STATIC_DCL void FDECL(restlevchn, (int));
@@ -42,6 +50,8 @@ STATIC_DCL int FDECL(restlevelfile, (int, XCHAR_P));
 STATIC_OVL void FDECL(restore_msghistory, (int));
 STATIC_DCL void FDECL(reset_oattached_mids, (BOOLEAN_P));
 STATIC_DCL void FDECL(rest_levl, (int, BOOLEAN_P));
+STATIC_DCL boolean FDECL(rest_chunktoc, (int, const char *));
+STATIC_DCL void FDECL(rest_chunk, (int, int));
 
 static struct restore_procs {
     const char *name;
@@ -60,21 +70,27 @@ static struct restore_procs {
 /*
  * Save a mapping of IDs from ghost levels to the current level.  This
  * map is used by the timer routines when restoring ghost levels.
+ * It is an open-addressing hash table with linear probing; the table
+ * doubles whenever it becomes half full, so its size follows the number
+ * of IDs actually mapped.
  */
-#define N_PER_BUCKET 64
-struct bucket {
-    struct bucket *next;
-    struct {
-        unsigned gid; /* ghost ID */
-        unsigned nid; /* new ID */
-    } map[N_PER_BUCKET];
+#define ID_MAP_MINSIZE 64 /* must be a power of 2 */
+struct id_map_entry {
+    unsigned gid; /* ghost ID */
+    unsigned nid; /* new ID */
+    boolean used;
 };
 
 STATIC_DCL void NDECL(clear_id_mapping);
 STATIC_DCL void FDECL(add_id_mapping, (unsigned, unsigned));
+STATIC_DCL struct id_map_entry *FDECL(find_id_slot, (struct id_map_entry *,
+                                                     unsigned, unsigned));
 
 static int n_ids_mapped = 0;
-static struct bucket *id_map = 0;
+static unsigned id_map_size = 0;
+static struct id_map_entry *id_map = 0;
+/* statistics for the most recent ghost level load, for wizard #stats */
+static long id_map_mapped = 0L, id_map_probes = 0L, id_map_peak = 0L;
 
 #ifdef AMII_GRAPHICS
 void FDECL(amii_setpens, (int)); /* use colors from save file */
@@ -519,9 +535,11 @@ unsigned int *stuckid, *steedid;
     struct sysflag newgamesysflags;
 #endif
     struct obj *otmp, *tmp_bc;
+    struct monst *mtmp;
     char timebuf[15];
     unsigned long uid;
 
+    rest_chunk(fd, SC_GAME);
     mread(fd, (genericptr_t) &uid, sizeof uid);
     if (SYSOPT_CHECK_SAVE_UID
         && uid != (unsigned long) getuid()) { /* strange ... */
@@ -561,6 +579,7 @@ unsigned int *stuckid, *steedid;
 #ifdef AMII_GRAPHICS
     amii_setpens(amii_numcolors); /* use colors from save file */
 #endif
+    rest_chunk(fd, SC_HERO);
     mread(fd, (genericptr_t) &u, sizeof(struct you));
 
 #define ReadTimebuf(foo)                   \
@@ -599,9 +618,13 @@ unsigned int *stuckid, *steedid;
     assign_level(&u.uz0, &u.uz);
 
     /* this stuff comes after potential aborted restore attempts */
+    rest_chunk(fd, SC_KILR);
     restore_killers(fd);
+    rest_chunk(fd, SC_TIMR);
     restore_timers(fd, RANGE_GLOBAL, FALSE, 0L);
+    rest_chunk(fd, SC_LITE);
     restore_light_sources(fd);
+    rest_chunk(fd, SC_INVT);
     invent = restobjchn(fd, FALSE, FALSE);
     /* tmp_bc only gets set here if the ball & chain were orphaned
        because you were swallowed; otherwise they will be on the floor
@@ -616,8 +639,12 @@ unsigned int *stuckid, *steedid;
             impossible("restgamestate: lost ball & chain");
     }
 
+    rest_chunk(fd, SC_MIGR);
     migrating_objs = restobjchn(fd, FALSE, FALSE);
     migrating_mons = restmonchn(fd, FALSE);
+    for (mtmp = migrating_mons; mtmp; mtmp = mtmp->nmon)
+        mid_index_add(mtmp, FM_MIGRATE);
+    rest_chunk(fd, SC_VITL);
     mread(fd, (genericptr_t) mvitals, sizeof(mvitals));
 
     /*
@@ -641,14 +668,20 @@ unsigned int *stuckid, *steedid;
     if (!uwep || uwep->otyp == PICK_AXE || uwep->otyp == GRAPPLING_HOOK)
         unweapon = TRUE;
 
+    rest_chunk(fd, SC_DUNG);
     restore_dungeon(fd);
+    rest_chunk(fd, SC_LVCH);
     restlevchn(fd);
+    rest_chunk(fd, SC_MISC);
     mread(fd, (genericptr_t) &moves, sizeof moves);
     mread(fd, (genericptr_t) &monstermoves, sizeof monstermoves);
     mread(fd, (genericptr_t) &quest_status, sizeof(struct q_score));
     mread(fd, (genericptr_t) spl_book, sizeof(struct spell) * (MAXSPELL + 1));
+    rest_chunk(fd, SC_ARTI);
     restore_artifacts(fd);
+    rest_chunk(fd, SC_ORCL);
     restore_oracles(fd);
+    rest_chunk(fd, SC_PLAY);
     if (u.ustuck)
         mread(fd, (genericptr_t) stuckid, sizeof(*stuckid));
     if (u.usteed)
@@ -657,10 +690,18 @@ unsigned int *stuckid, *steedid;
 
     mread(fd, (genericptr_t) pl_fruit, sizeof pl_fruit);
     freefruitchn(ffruit); /* clean up fruit(s) made by initoptions() */
+    rest_chunk(fd, SC_FRUT);
     ffruit = loadfruitchn(fd);
 
+    rest_chunk(fd, SC_NAME);
     restnames(fd);
+    rest_chunk(fd, SC_WATR);
     restore_waterlevel(fd);
+    if ((sfrestinfo.sfi2 & SFI2_RNGSTATE) != 0) {
+        rest_chunk(fd, SC_RNGS);
+        rest_rng(fd);
+    }
+    rest_chunk(fd, SC_MSGH);
     restore_msghistory(fd);
     /* must come after all mons & objs are restored */
     relink_timers(FALSE);
@@ -678,18 +719,12 @@ unsigned int stuckid, steedid;
     register struct monst *mtmp;
 
     if (stuckid) {
-        for (mtmp = fmon; mtmp; mtmp = mtmp->nmon)
-            if (mtmp->m_id == stuckid)
-                break;
-        if (!mtmp)
+        if (!(mtmp = find_mid(stuckid, FM_FMON)))
             panic("Cannot find the monster ustuck.");
         u.ustuck = mtmp;
     }
     if (steedid) {
-        for (mtmp = fmon; mtmp; mtmp = mtmp->nmon)
-            if (mtmp->m_id == steedid)
-                break;
-        if (!mtmp)
+        if (!(mtmp = find_mid(steedid, FM_FMON)))
             panic("Cannot find the monster usteed.");
         u.usteed = mtmp;
         remove_monster(mtmp->mx, mtmp->my);
@@ -764,7 +799,7 @@ register int fd;
     struct obj *otmp;
 
     restoring = TRUE;
-    get_plname_from_file(fd, plname);
+    get_plname_from_file(fd, plname, (struct save_summary *) 0);
     getlev(fd, 0, (xchar) 0, FALSE);
     if (!restgamestate(fd, &stuckid, &steedid)) {
         display_nhwindow(WIN_MESSAGE, TRUE);
@@ -842,7 +877,7 @@ register int fd;
     (void) lseek(fd, (off_t) 0, 0);
 #endif
     (void) validate(fd, (char *) 0); /* skip version and savefile info */
-    get_plname_from_file(fd, plname);
+    get_plname_from_file(fd, plname, (struct save_summary *) 0);
 
     getlev(fd, 0, (xchar) 0, FALSE);
     (void) nhclose(fd);
@@ -984,8 +1019,10 @@ boolean ghostly;
     short tlev;
 #endif
 
-    if (ghostly)
+    if (ghostly) {
         clear_id_mapping();
+        id_map_mapped = id_map_probes = id_map_peak = 0L;
+    }
 
 #if defined(MSDOS) || defined(OS2)
     setmode(fd, O_BINARY);
@@ -993,10 +1030,13 @@ boolean ghostly;
     /* Load the old fruit info.  We have to do it first, so the
      * information is available when restoring the objects.
      */
-    if (ghostly)
+    if (ghostly) {
+        rest_chunk(fd, SC_FRUT);
         oldfruit = loadfruitchn(fd);
+    }
 
     /* First some sanity checks */
+    rest_chunk(fd, SC_LEVL);
     mread(fd, (genericptr_t) &hpid, sizeof(hpid));
 /* CHECK:  This may prevent restoration */
 #ifdef TOS
@@ -1038,25 +1078,35 @@ boolean ghostly;
     else
         doorindex = 0;
 
+    rest_chunk(fd, SC_TIMR);
     restore_timers(fd, RANGE_LEVEL, ghostly, elapsed);
+    rest_chunk(fd, SC_LITE);
     restore_light_sources(fd);
+    rest_chunk(fd, SC_MONS);
     fmon = restmonchn(fd, ghostly);
 
     rest_worm(fd); /* restore worm information */
+    rest_chunk(fd, SC_TRAP);
     ftrap = 0;
+    for (x = 0; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++)
+            remove_trap_at(x, y);
     while (trap = newtrap(),
            mread(fd, (genericptr_t) trap, sizeof(struct trap)),
            trap->tx != 0) { /* need "!= 0" to work around DICE 3.0 bug */
         trap->ntrap = ftrap;
         ftrap = trap;
+        place_trap_at(trap);
     }
     dealloc_trap(trap);
+    rest_chunk(fd, SC_OBJS);
     fobj = restobjchn(fd, ghostly, FALSE);
     find_lev_obj();
     /* restobjchn()'s `frozen' argument probably ought to be a callback
        routine so that we can check for objects being buried under ice */
     level.buriedobjlist = restobjchn(fd, ghostly, FALSE);
     billobjs = restobjchn(fd, ghostly, FALSE);
+    rest_chunk(fd, SC_ENGR);
     rest_engravings(fd);
 
     /* reset level.monsters for new level */
@@ -1064,6 +1114,7 @@ boolean ghostly;
         for (y = 0; y < ROWNO; y++)
             level.monsters[x][y] = (struct monst *) 0;
     for (mtmp = fmon; mtmp; mtmp = mtmp->nmon) {
+        mid_index_add(mtmp, FM_FMON);
         if (mtmp->isshk)
             set_residency(mtmp, FALSE);
         place_monster(mtmp, mtmp->mx, mtmp->my);
@@ -1094,7 +1145,9 @@ boolean ghostly;
             hide_monst(mtmp);
     }
 
+    rest_chunk(fd, SC_DAMG);
     restdamage(fd, ghostly);
+    rest_chunk(fd, SC_REGN);
     rest_regions(fd, ghostly);
     if (ghostly) {
         /* Now get rid of all the temp fruits... */
@@ -1156,33 +1209,155 @@ boolean ghostly;
 }
 
 void
-get_plname_from_file(fd, plbuf)
+get_plname_from_file(fd, plbuf, ss)
 int fd;
 char *plbuf;
+struct save_summary *ss; /* if non-null, also return the game summary */
 {
     int pltmpsiz = 0;
     (void) read(fd, (genericptr_t) &pltmpsiz, sizeof(pltmpsiz));
     (void) read(fd, (genericptr_t) plbuf, pltmpsiz);
+    if ((sfrestinfo.sfi2 & SFI2_SAVEINFO) == 0
+        || !get_saveinfo_from_file(fd, ss)) {
+        if (ss) {
+            /* older file; just the name is known */
+            (void) memset((genericptr_t) ss, 0, sizeof *ss);
+            (void) strncpy(ss->plname, plbuf, PL_NSIZ - 1);
+        }
+    }
     return;
 }
 
+/* read the game summary that follows the player name (see global.h);
+   ss may be null to just skip over it */
+boolean
+get_saveinfo_from_file(fd, ss)
+int fd;
+struct save_summary *ss;
+{
+    unsigned char hdr[8], buf[1024];
+    unsigned len, pos, flen, i;
+    long num;
+    char *dest;
+    unsigned dsz;
+
+    if (read(fd, (genericptr_t) hdr, sizeof hdr) != sizeof hdr
+        || hdr[0] != 'N' || hdr[1] != 'H' || hdr[2] != 's' || hdr[3] != 'i')
+        return FALSE;
+    len = hdr[6] | ((unsigned) hdr[7] << 8);
+    if (len > sizeof buf
+        || read(fd, (genericptr_t) buf, len) != (int) len)
+        return FALSE;
+    /* a newer summary version may have changed the meaning of old tags */
+    if ((hdr[4] | ((unsigned) hdr[5] << 8)) != SAVEINFO_VERSION || !ss)
+        return FALSE;
+
+    (void) memset((genericptr_t) ss, 0, sizeof *ss);
+    for (pos = 0; pos + 2 <= len; pos += flen) {
+        int tag = buf[pos++];
+
+        flen = buf[pos++];
+        if (pos + flen > len)
+            break;
+        num = 0L;
+        if (flen == 4)
+            for (i = 0; i < 4; i++)
+                num |= (long) buf[pos + i] << (8 * i);
+        dest = 0, dsz = 0;
+        switch (tag) {
+        case SI_PLNAME:
+            dest = ss->plname;
+            dsz = PL_NSIZ;
+            break;
+        case SI_ROLE:
+            dest = ss->role;
+            dsz = sizeof ss->role;
+            break;
+        case SI_RACE:
+            dest = ss->race;
+            dsz = sizeof ss->race;
+            break;
+        case SI_GENDER:
+            dest = ss->gender;
+            dsz = sizeof ss->gender;
+            break;
+        case SI_ALIGN:
+            dest = ss->align;
+            dsz = sizeof ss->align;
+            break;
+        case SI_DUNGEON:
+            dest = ss->dungeon;
+            dsz = sizeof ss->dungeon;
+            break;
+        case SI_MODE:
+            ss->mode = flen ? (char) buf[pos] : '\0';
+            break;
+        case SI_DEPTH:
+            ss->depth = num;
+            break;
+        case SI_MOVES:
+            ss->moves = num;
+            break;
+        case SI_ULEVEL:
+            ss->ulevel = num;
+            break;
+        case SI_HP:
+            ss->hp = num;
+            break;
+        case SI_HPMAX:
+            ss->hpmax = num;
+            break;
+        case SI_SAVETIME:
+            ss->savetime = num;
+            break;
+        default: /* unknown tag from a later version; skip it */
+            break;
+        }
+        if (dest) {
+            i = min(flen, dsz - 1);
+            (void) memcpy((genericptr_t) dest, (genericptr_t) &buf[pos], i);
+            dest[i] = '\0';
+        }
+    }
+    return TRUE;
+}
+
 STATIC_OVL void
 restore_msghistory(fd)
 register int fd;
 {
-    int msgsize, msgcount = 0;
-    char msg[BUFSZ];
-
-    while (1) {
-        mread(fd, (genericptr_t) &msgsize, sizeof(msgsize));
-        if (msgsize == -1)
-            break;
-        if (msgsize > (BUFSZ - 1))
-            panic("restore_msghistory: msg too big (%d)", msgsize);
-        mread(fd, (genericptr_t) msg, msgsize);
-        msg[msgsize] = '\0';
-        putmsghistory(msg, TRUE);
-        ++msgcount;
+    int msgsize, msgcount = 0, i;
+    unsigned blklen;
+    char msg[BUFSZ], *blk, *p;
+
+    mread(fd, (genericptr_t) &msgsize, sizeof(msgsize));
+    if (msgsize == MSGHIST_BLOCK) {
+        /* whole history in one block of NUL terminated messages */
+        mread(fd, (genericptr_t) &msgcount, sizeof msgcount);
+        mread(fd, (genericptr_t) &blklen, sizeof blklen);
+        if (msgcount < 0 || blklen > (unsigned) msgcount * BUFSZ)
+            panic("restore_msghistory: bad history (%d, %u)", msgcount,
+                  blklen);
+        blk = (char *) alloc(blklen + 1);
+        if (blklen)
+            mread(fd, (genericptr_t) blk, blklen);
+        blk[blklen] = '\0';
+        for (i = 0, p = blk; i < msgcount && p < blk + blklen; ++i) {
+            putmsghistory(p, TRUE);
+            p = eos(p) + 1;
+        }
+        free((genericptr_t) blk);
+    } else {
+        /* older save file: length and text of each message in turn */
+        while (msgsize != -1) {
+            if (msgsize > (BUFSZ - 1))
+                panic("restore_msghistory: msg too big (%d)", msgsize);
+            mread(fd, (genericptr_t) msg, msgsize);
+            msg[msgsize] = '\0';
+            putmsghistory(msg, TRUE);
+            ++msgcount;
+            mread(fd, (genericptr_t) &msgsize, sizeof(msgsize));
+        }
     }
     if (msgcount)
         putmsghistory((char *) 0, TRUE);
@@ -1193,13 +1368,26 @@ register int fd;
 STATIC_OVL void
 clear_id_mapping()
 {
-    struct bucket *curr;
+    if (id_map)
+        free((genericptr_t) id_map);
+    id_map = (struct id_map_entry *) 0;
+    id_map_size = 0;
+    n_ids_mapped = 0;
+}
 
-    while ((curr = id_map) != 0) {
-        id_map = curr->next;
-        free((genericptr_t) curr);
+/* Find the slot holding gid, or the empty slot where it belongs. */
+STATIC_OVL struct id_map_entry *
+find_id_slot(map, size, gid)
+struct id_map_entry *map;
+unsigned size, gid;
+{
+    unsigned i = (gid * 2654435761U) & (size - 1);
+
+    while (map[i].used && map[i].gid != gid) {
+        ++id_map_probes;
+        i = (i + 1) & (size - 1);
     }
-    n_ids_mapped = 0;
+    return &map[i];
 }
 
 /* Add a mapping to the ID map. */
@@ -1207,20 +1395,32 @@ STATIC_OVL void
 add_id_mapping(gid, nid)
 unsigned gid, nid;
 {
-    int idx;
-
-    idx = n_ids_mapped % N_PER_BUCKET;
-    /* idx is zero on first time through, as well as when a new bucket is */
-    /* needed */
-    if (idx == 0) {
-        struct bucket *gnu = (struct bucket *) alloc(sizeof(struct bucket));
-        gnu->next = id_map;
-        id_map = gnu;
+    struct id_map_entry *slot;
+
+    if (2 * (n_ids_mapped + 1) > (int) id_map_size) {
+        struct id_map_entry *oldmap = id_map;
+        unsigned i, oldsize = id_map_size;
+
+        id_map_size = oldsize ? 2 * oldsize : ID_MAP_MINSIZE;
+        id_map = (struct id_map_entry *) alloc(id_map_size * sizeof *id_map);
+        (void) memset((genericptr_t) id_map, 0, id_map_size * sizeof *id_map);
+        for (i = 0; i < oldsize; i++)
+            if (oldmap[i].used)
+                *find_id_slot(id_map, id_map_size, oldmap[i].gid) = oldmap[i];
+        if (oldmap)
+            free((genericptr_t) oldmap);
+        if ((long) (id_map_size * sizeof *id_map) > id_map_peak)
+            id_map_peak = (long) (id_map_size * sizeof *id_map);
     }
 
-    id_map->map[idx].gid = gid;
-    id_map->map[idx].nid = nid;
-    n_ids_mapped++;
+    slot = find_id_slot(id_map, id_map_size, gid);
+    if (!slot->used) {
+        slot->used = TRUE;
+        slot->gid = gid;
+        n_ids_mapped++;
+        id_map_mapped++;
+    }
+    slot->nid = nid; /* most recent mapping for a given ghost ID wins */
 }
 
 /*
@@ -1232,29 +1432,32 @@ boolean
 lookup_id_mapping(gid, nidp)
 unsigned gid, *nidp;
 {
-    int i;
-    struct bucket *curr;
-
-    if (n_ids_mapped)
-        for (curr = id_map; curr; curr = curr->next) {
-            /* first bucket might not be totally full */
-            if (curr == id_map) {
-                i = n_ids_mapped % N_PER_BUCKET;
-                if (i == 0)
-                    i = N_PER_BUCKET;
-            } else
-                i = N_PER_BUCKET;
-
-            while (--i >= 0)
-                if (gid == curr->map[i].gid) {
-                    *nidp = curr->map[i].nid;
-                    return TRUE;
-                }
+    struct id_map_entry *slot;
+
+    if (n_ids_mapped) {
+        slot = find_id_slot(id_map, id_map_size, gid);
+        if (slot->used) {
+            *nidp = slot->nid;
+            return TRUE;
         }
+    }
 
     return FALSE;
 }
 
+/* to support '#stats' wizard-mode command; the map itself only lives
+   while a ghost level is being loaded, so report on the last such load */
+void
+id_map_stats(hdrfmt, hdrbuf, count, size)
+const char *hdrfmt;
+char *hdrbuf;
+long *count, *size;
+{
+    Sprintf(hdrbuf, hdrfmt, id_map_probes);
+    *count = id_map_mapped;
+    *size = id_map_peak;
+}
+
 STATIC_OVL void
 reset_oattached_mids(ghostly)
 boolean ghostly;
@@ -1368,6 +1571,42 @@ register unsigned int len;
     return;
 }
 
+/* in-memory copy of a level file; reads from mimg.fd are served from it */
+static struct {
+    int fd;
+    const char *data;
+    unsigned len, pos;
+} mimg = { -1, (const char *) 0, 0, 0 };
+
+/* attach a memory image of the file open as fd; fd -1 detaches */
+void
+mread_image(fd, data, len)
+int fd;
+const char *data;
+unsigned len;
+{
+    mimg.fd = fd;
+    mimg.data = data;
+    mimg.len = len;
+    mimg.pos = 0;
+}
+
+/* lowest level of mread(): read() from fd or from its attached image */
+STATIC_OVL int
+rawread(fd, buf, len)
+int fd;
+genericptr_t buf;
+unsigned int len;
+{
+    if (fd < 0 || fd != mimg.fd)
+        return read(fd, buf, len);
+    if (len > mimg.len - mimg.pos)
+        len = mimg.len - mimg.pos;
+    (void) memcpy(buf, (genericptr_t) (mimg.data + mimg.pos), len);
+    mimg.pos += len;
+    return (int) len;
+}
+
 /* examine the version info and the savefile_info data
    that immediately follows it.
    Return 0 if it passed the checks.
@@ -1399,6 +1638,22 @@ const char *name;
         return -1;
     }
 
+    /* remember whether get_plname_from_file() has a summary to skip */
+    if ((sfi.sfi2 & SFI2_SAVEINFO) != 0)
+        sfrestinfo.sfi2 |= SFI2_SAVEINFO;
+    else
+        sfrestinfo.sfi2 &= ~SFI2_SAVEINFO;
+    /* and whether the game carries its random number state */
+    if ((sfi.sfi2 & SFI2_RNGSTATE) != 0)
+        sfrestinfo.sfi2 |= SFI2_RNGSTATE;
+    else
+        sfrestinfo.sfi2 &= ~SFI2_RNGSTATE;
+    /* and whether its data is divided into chunks */
+    if ((sfi.sfi2 & SFI2_CHUNKS) != 0)
+        sfrestinfo.sfi2 |= SFI2_CHUNKS;
+    else
+        sfrestinfo.sfi2 &= ~SFI2_CHUNKS;
+
     compatible = (sfi.sfi1 & sfcap.sfi1);
 
     if ((sfi.sfi1 & SFI1_ZEROCOMP) == SFI1_ZEROCOMP) {
@@ -1428,6 +1683,20 @@ const char *name;
         }
     }
 
+    if ((sfi.sfi1 & SFI1_LZCOMP) == SFI1_LZCOMP) {
+        if ((compatible & SFI1_LZCOMP) != SFI1_LZCOMP
+            || (sfi.sfi1 & SFI1_LZVERSMASK)
+                   != SFI1_LZVERSION(LZCOMP_VERSION)) {
+            if (verbose) {
+                pline("File \"%s\" has incompatible LZ compression.", name);
+                wait_synch();
+            }
+            return 2;
+        } else if ((sfrestinfo.sfi1 & SFI1_LZCOMP) != SFI1_LZCOMP) {
+            set_restpref("lzcomp");
+        }
+    }
+
     /* RLECOMP check must be last, after ZEROCOMP or INTERNALCOMP adjustments
      */
     if ((sfi.sfi1 & SFI1_RLECOMP) == SFI1_RLECOMP) {
@@ -1446,12 +1715,88 @@ const char *name;
     else
         set_restpref("!rlecomp");
 
+    if ((sfi.sfi2 & SFI2_CHUNKS) != 0 && !rest_chunktoc(fd, name))
+        return 2;
+
     return 0;
 }
 
+/* read the table of contents following the savefile info and check
+   that we know how to read every chunk it lists */
+STATIC_OVL boolean
+rest_chunktoc(fd, name)
+int fd;
+const char *name;
+{
+    unsigned char buf[CHUNKTOC_ENTSZ];
+    const char *why = 0;
+    unsigned long size;
+    unsigned seen = 0, cnt;
+    int i, which;
+
+    if (read(fd, (genericptr_t) buf, 6) != 6
+        || strncmp((char *) buf, "NHtc", 4))
+        why = "has a damaged table of contents";
+    cnt = (unsigned) buf[4] | ((unsigned) buf[5] << 8);
+    while (!why && cnt-- > 0) {
+        if (read(fd, (genericptr_t) buf, CHUNKTOC_ENTSZ) != CHUNKTOC_ENTSZ) {
+            why = "has a damaged table of contents";
+            break;
+        }
+        for (size = 0L, i = 3; i >= 0; i--)
+            size = (size << 8) | buf[4 + i];
+        for (which = 0; which < NUM_SAVE_CHUNKS; which++)
+            if (!strncmp((char *) buf, save_chunks[which].tag, 4))
+                break;
+        if (which == NUM_SAVE_CHUNKS)
+            why = "has a kind of data this version does not know";
+        else if (size != save_chunks[which].size)
+            why = "has data of an unexpected size";
+        else
+            seen |= 1U << which;
+    }
+    if (!why && seen != (1U << NUM_SAVE_CHUNKS) - 1U)
+        why = "is missing some of its data";
+    if (why) {
+        if (name) {
+            pline("File \"%s\" %s.", name, why);
+            wait_synch();
+        }
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* read the start of a chunk and make sure it is the expected one */
+STATIC_OVL void
+rest_chunk(fd, which)
+int fd, which;
+{
+    const char *tag = save_chunks[which].tag;
+    char hdr[4];
+
+    if ((sfrestinfo.sfi2 & SFI2_CHUNKS) == 0)
+        return; /* file from before chunks */
+    mread(fd, (genericptr_t) hdr, (unsigned) sizeof hdr);
+    if (strncmp(hdr, tag, 4)) {
+        pline("Expected %s data.", tag);
+        if (restoring) {
+            (void) nhclose(fd);
+            (void) delete_savefile();
+            error("Error restoring old game.");
+        }
+        panic("Error reading level file.");
+    }
+}
+
 void
 reset_restpref()
 {
+#ifdef LZCOMP
+    if (iflags.lzcomp)
+        set_restpref("lzcomp");
+    else
+#endif
 #ifdef ZEROCOMP
     if (iflags.zerocomp)
         set_restpref("zerocomp");
@@ -1464,6 +1809,8 @@ reset_restpref()
     else
 #endif
         set_restpref("!rlecomp");
+    /* level files we write ourselves have our own chunks */
+    sfrestinfo.sfi2 |= SFI2_CHUNKS;
 }
 
 void
@@ -1475,7 +1822,7 @@ const char *suitename;
         restoreprocs.restore_mread = def_mread;
         restoreprocs.restore_minit = def_minit;
         sfrestinfo.sfi1 |= SFI1_EXTERNALCOMP;
-        sfrestinfo.sfi1 &= ~SFI1_ZEROCOMP;
+        sfrestinfo.sfi1 &= ~(SFI1_ZEROCOMP | SFI1_LZCOMP | SFI1_LZVERSMASK);
         def_minit();
     }
     if (!strcmpi(suitename, "!rlecomp")) {
@@ -1487,10 +1834,22 @@ const char *suitename;
         restoreprocs.restore_mread = zerocomp_mread;
         restoreprocs.restore_minit = zerocomp_minit;
         sfrestinfo.sfi1 |= SFI1_ZEROCOMP;
-        sfrestinfo.sfi1 &= ~SFI1_EXTERNALCOMP;
+        sfrestinfo.sfi1 &= ~(SFI1_EXTERNALCOMP | SFI1_LZCOMP
+                             | SFI1_LZVERSMASK);
         zerocomp_minit();
     }
 #endif
+#ifdef LZCOMP
+    if (!strcmpi(suitename, "lzcomp")) {
+        restoreprocs.name = "lzcomp";
+        restoreprocs.restore_mread = lzcomp_mread;
+        restoreprocs.restore_minit = lzcomp_minit;
+        sfrestinfo.sfi1 &= ~(SFI1_EXTERNALCOMP | SFI1_ZEROCOMP
+                             | SFI1_LZVERSMASK);
+        sfrestinfo.sfi1 |= SFI1_LZCOMP | SFI1_LZVERSION(LZCOMP_VERSION);
+        lzcomp_minit();
+    }
+#endif
 #ifdef RLECOMP
     if (!strcmpi(suitename, "rlecomp")) {
         sfrestinfo.sfi1 |= SFI1_RLECOMP;
@@ -1514,7 +1873,7 @@ STATIC_OVL int
 zerocomp_mgetc()
 {
     if (inbufp >= inbufsz) {
-        inbufsz = read(mreadfd, (genericptr_t) inbuf, sizeof inbuf);
+        inbufsz = rawread(mreadfd, (genericptr_t) inbuf, sizeof inbuf);
         if (!inbufsz) {
             if (inbufp > sizeof inbuf)
                 error("EOF on file #%d.\n", mreadfd);
@@ -1563,6 +1922,122 @@ register unsigned len;
 }
 #endif /* ZEROCOMP */
 
+#ifdef LZCOMP
+/* see save.c for a description of the block format */
+static NEARDATA unsigned char lz_rdbuf[LZBLOCKSZ];
+static NEARDATA unsigned char lz_pkbuf[LZBLOCKSZ];
+static NEARDATA unsigned lz_rdlen = 0, lz_rdpos = 0;
+
+STATIC_OVL void
+lzcomp_minit()
+{
+    lz_rdlen = lz_rdpos = 0;
+}
+
+/* unpack one block; FALSE if the data doesn't make sense */
+STATIC_OVL boolean
+lz_unpack(src, srclen, dst, dstlen)
+const unsigned char *src;
+unsigned srclen;
+unsigned char *dst;
+unsigned dstlen;
+{
+    unsigned ip = 0, op = 0, n, off, c;
+
+    while (ip < srclen) {
+        c = src[ip++];
+        n = c >> 4;
+        if (n == 15)
+            do {
+                if (ip >= srclen)
+                    return FALSE;
+                n += src[ip];
+            } while (src[ip++] == 255);
+        if (n > srclen - ip || n > dstlen - op)
+            return FALSE;
+        (void) memcpy((genericptr_t) &dst[op], (genericptr_t) &src[ip], n);
+        ip += n, op += n;
+        if (ip == srclen)
+            break; /* final sequence has no match */
+        if (srclen - ip < 2)
+            return FALSE;
+        off = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        n = c & 15;
+        if (n == 15)
+            do {
+                if (ip >= srclen)
+                    return FALSE;
+                n += src[ip];
+            } while (src[ip++] == 255);
+        n += LZMINMATCH;
+        if (!off || off > op || n > dstlen - op)
+            return FALSE;
+        for (; n; n--, op++) /* may overlap; must go forwards */
+            dst[op] = dst[op - off];
+    }
+    return (boolean) (op == dstlen);
+}
+
+/* read and unpack the next block; FALSE at end of file or on error */
+STATIC_OVL boolean
+lz_readblock(fd)
+int fd;
+{
+    unsigned char hdr[4];
+    unsigned rawlen, plen;
+
+    if (rawread(fd, (genericptr_t) hdr, sizeof hdr) != (int) sizeof hdr)
+        return FALSE;
+    rawlen = hdr[0] | (hdr[1] << 8);
+    plen = hdr[2] | (hdr[3] << 8);
+    if (!rawlen || rawlen > LZBLOCKSZ || plen > rawlen)
+        return FALSE;
+    if (plen == rawlen) {
+        if (rawread(fd, (genericptr_t) lz_rdbuf, rawlen) != (int) rawlen)
+            return FALSE;
+    } else if (rawread(fd, (genericptr_t) lz_pkbuf, plen) != (int) plen
+               || !lz_unpack(lz_pkbuf, plen, lz_rdbuf, rawlen)) {
+        return FALSE;
+    }
+    lz_rdlen = rawlen;
+    lz_rdpos = 0;
+    return TRUE;
+}
+
+STATIC_OVL void
+lzcomp_mread(fd, buf, len)
+int fd;
+genericptr_t buf;
+register unsigned len;
+{
+    char *bp = (char *) buf;
+    unsigned n;
+
+    if (fd < 0)
+        error("Restore error; mread attempting to read file %d.", fd);
+    while (len) {
+        if (lz_rdpos >= lz_rdlen && !lz_readblock(fd)) {
+            if (restoreprocs.mread_flags == 1) { /* means "return anyway" */
+                restoreprocs.mread_flags = -1;
+                return;
+            }
+            pline("Read error in compressed file #%d.", fd);
+            if (restoring) {
+                (void) nhclose(fd);
+                (void) delete_savefile();
+                error("Error restoring old game.");
+            }
+            panic("Error reading level file.");
+        }
+        n = min(len, lz_rdlen - lz_rdpos);
+        (void) memcpy((genericptr_t) bp, (genericptr_t) &lz_rdbuf[lz_rdpos],
+                      n);
+        lz_rdpos += n, bp += n, len -= n;
+    }
+}
+#endif /* LZCOMP */
+
 STATIC_OVL void
 def_minit()
 {
@@ -1582,7 +2057,7 @@ register unsigned int len;
 #define readLenType unsigned
 #endif
 
-    rlen = read(fd, buf, (readLenType) len);
+    rlen = rawread(fd, buf, len);
     if ((readLenType) rlen != (readLenType) len) {
         if (restoreprocs.mread_flags == 1) { /* means "return anyway" */
             restoreprocs.mread_flags = -1;
@@ -3,19 +3,151 @@
 /* NetHack may be freely redistributed.  See license for details. */
 
 #include "hack.h"
+#include "lev.h"
+#include "integer.h"
 
-/* "Rand()"s definition is determined by [OS]conf.h */
-#if defined(LINT) && defined(UNIX) /* rand() is long... */
-extern int NDECL(rand);
-#define RND(x) (rand() % x)
-#else /* LINT */
-#if defined(UNIX) || defined(RANDOM)
-#define RND(x) ((int) (Rand() % (long) (x)))
-#else
-/* Good luck: the bottom order bits are cyclic. */
-#define RND(x) ((int) ((Rand() >> 3) % (x)))
-#endif
-#endif /* LINT */
+/*
+ * The game's random numbers come from its own xoshiro128** generator
+ * (Blackman and Vigna) rather than the C library's, so that a seed
+ * gives the same game on every platform.  Level creation draws from
+ * a stream of its own, restarted for each level from the game's level
+ * seed and that level's ledger number; a given seed thus builds the
+ * same level no matter how play went before it was reached (as long
+ * as that didn't change what may be generated there, such as which
+ * artifacts or unique monsters already exist).
+ */
+
+struct rng {
+    uint32 s[4];
+};
+
+static struct rng rngs[NUM_RNGS];
+static struct rng *rng = &rngs[RNG_CORE]; /* the stream in use */
+static uint32 levelseed[2];
+
+#define ROTL(x, k) (((x) << (k)) | ((x) >> (32 - (k))))
+
+STATIC_DCL uint32 NDECL(rng_next);
+STATIC_DCL uint32 FDECL(rng_mix, (uint32));
+STATIC_DCL void FDECL(rng_init, (struct rng *, uint32, uint32));
+STATIC_DCL int FDECL(rng_bounded, (int));
+
+/* next 32 bits from the current stream */
+STATIC_OVL uint32
+rng_next()
+{
+    uint32 *s = rng->s, r = ROTL(s[1] * 5, 7) * 9, t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = ROTL(s[3], 11);
+    return r;
+}
+
+/* scramble a word so that nearby seeds give unrelated states */
+STATIC_OVL uint32
+rng_mix(h)
+uint32 h;
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6bUL;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35UL;
+    h ^= h >> 16;
+    return h;
+}
+
+/* set up a stream from the two halves of a 64 bit seed */
+STATIC_OVL void
+rng_init(r, hi, lo)
+struct rng *r;
+uint32 hi, lo;
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+        r->s[i] = rng_mix(lo + (uint32) (i + 1) * 0x9e3779b9UL)
+                  ^ rng_mix(hi ^ (uint32) i);
+    if (!(r->s[0] | r->s[1] | r->s[2] | r->s[3]))
+        r->s[0] = 1; /* the one state xoshiro can't leave */
+}
+
+/* 0 <= rng_bounded(x) < x, without the bias of taking a plain modulo */
+STATIC_OVL int
+rng_bounded(x)
+int x;
+{
+    uint32 n = (uint32) x, lim, r;
+
+    if (n && !(n & (n - 1)))
+        return (int) (rng_next() & (n - 1));
+    /* reject the lowest 2^32 % n values so every residue is equally
+       likely; that's never more than half of them */
+    lim = ((uint32) 0 - n) % n;
+    do {
+        r = rng_next();
+    } while (r < lim);
+    return (int) (r % n);
+}
+
+#define RND(x) rng_bounded(x)
+
+/* seed every stream; called at startup, and by anything that wants a
+   game to be played over again from the same seed */
+void
+init_rng(seed)
+unsigned long seed;
+{
+    uint32 hi = (uint32) ((seed >> 16) >> 16), lo = (uint32) seed;
+
+    rng_init(&rngs[RNG_CORE], hi, lo);
+    levelseed[0] = rng_mix(hi) ^ 0x6c65766cUL; /* "levl" */
+    levelseed[1] = lo;
+    rng_level(0);
+    rng = &rngs[RNG_CORE];
+}
+
+/* draw from stream 'which' until told otherwise; returns the one that
+   was in use so that it can be put back */
+int
+rng_select(which)
+int which;
+{
+    int old = (int) (rng - rngs);
+
+    rng = &rngs[which];
+    return old;
+}
+
+/* restart the level creation stream for the level with ledger number lev */
+void
+rng_level(lev)
+int lev;
+{
+    rng_init(&rngs[RNG_LEVEL], levelseed[0], levelseed[1] + (uint32) lev);
+}
+
+void
+save_rng(fd, mode)
+int fd, mode;
+{
+    if (perform_bwrite(mode)) {
+        bwrite(fd, (genericptr_t) rngs, sizeof rngs);
+        bwrite(fd, (genericptr_t) levelseed, sizeof levelseed);
+    }
+}
+
+void
+rest_rng(fd)
+int fd;
+{
+    mread(fd, (genericptr_t) rngs, sizeof rngs);
+    mread(fd, (genericptr_t) levelseed, sizeof levelseed);
+    rng = &rngs[RNG_CORE];
+}
 
 /* 0 <= rn2(x) < x */
 int
@@ -160,4 +292,49 @@ int i;
     return (int) x;
 }
 
+/* #wizbench: the generator against the C library's, which the old
+   RND() took modulo x */
+void
+rnd_bench(win)
+winid win;
+{
+    char buf[BUFSZ];
+    struct rng save[NUM_RNGS];
+    long t[4], calls = 1000000L, i;
+    int k;
+
+    (void) memcpy((genericptr_t) save, (genericptr_t) rngs, sizeof save);
+    for (k = 0; k < 4; k++) {
+        t[k] = cputime_ms();
+        switch (k) {
+        case 0:
+            for (i = 0; i < calls; i++)
+                (void) rn2(37);
+            break;
+        case 1:
+            for (i = 0; i < calls; i++)
+                (void) rnd(20);
+            break;
+        case 2:
+            for (i = 0; i < calls; i++)
+                (void) d(3, 6);
+            break;
+        default:
+            for (i = 0; i < calls; i++)
+                (void) (Rand() % 37L);
+            break;
+        }
+        t[k] = cputime_ms() - t[k];
+    }
+    (void) memcpy((genericptr_t) rngs, (genericptr_t) save, sizeof save);
+
+    Sprintf(buf, "rnd: %ld calls, rn2 %ld/s, rnd %ld/s, d(3,6) %ld/s,", calls,
+            calls * 1000L / max(t[0], 1L), calls * 1000L / max(t[1], 1L),
+            calls * 1000L / max(t[2], 1L));
+    putstr(win, 0, buf);
+    Sprintf(buf, "     C library Rand() %% 37 %ld/s",
+            calls * 1000L / max(t[3], 1L));
+    putstr(win, 0, buf);
+}
+
 /*rnd.c*/
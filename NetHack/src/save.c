@@ -22,6 +22,39 @@ static int count_only;
 int dotcnt, dotrow; /* also used in restore */
 #endif
 
+/* the chunks of saved data (see lev.h) */
+const struct save_chunk save_chunks[NUM_SAVE_CHUNKS] = {
+    { "GAME", sizeof(struct context_info) + sizeof(struct flag) },
+    { "HERO", sizeof(struct you) },
+    { "KILR", sizeof(struct kinfo) },
+    { "TIMR", sizeof(timer_element) },
+    { "LITE", sizeof(light_source) },
+    { "INVT", sizeof(struct obj) },
+    { "MIGR", sizeof(struct obj) + sizeof(struct monst) },
+    { "VITL", sizeof mvitals },
+    { "DUNG", sizeof(dungeon) + sizeof(branch) + sizeof(struct linfo)
+                  + sizeof(mapseen) },
+    { "LVCH", sizeof(s_level) },
+    { "MISC", sizeof(struct q_score) + sizeof(struct spell) },
+    { "ARTI", 0 },
+    { "ORCL", 0 },
+    { "PLAY", sizeof pl_character + sizeof pl_fruit },
+    { "FRUT", sizeof(struct fruit) },
+    { "NAME", sizeof(struct objclass) },
+    { "WATR", sizeof(struct bubble) },
+    { "RNGS", 0 },
+    { "MSGH", 0 },
+    { "LEVL", sizeof(struct rm) + sizeof(struct levelflags)
+                  + sizeof(struct mkroom) + sizeof(stairway)
+                  + sizeof(struct cemetery) },
+    { "MONS", sizeof(struct monst) },
+    { "TRAP", sizeof(struct trap) },
+    { "OBJS", sizeof(struct obj) },
+    { "ENGR", sizeof(struct engr) },
+    { "DAMG", sizeof(struct damage) },
+    { "REGN", sizeof(NhRegion) },
+};
+
 STATIC_DCL void FDECL(savelevchn, (int, int));
 STATIC_DCL void FDECL(savedamage, (int, int));
 STATIC_DCL void FDECL(saveobj, (int, struct obj *));
@@ -31,6 +64,11 @@ STATIC_DCL void FDECL(savemonchn, (int, struct monst *, int));
 STATIC_DCL void FDECL(savetrapchn, (int, struct trap *, int));
 STATIC_DCL void FDECL(savegamestate, (int, int));
 STATIC_OVL void FDECL(save_msghistory, (int, int));
+STATIC_DCL void FDECL(store_chunktoc, (int));
+STATIC_DCL unsigned FDECL(saveinfo_str, (unsigned char *, unsigned, int,
+                                         const char *));
+STATIC_DCL unsigned FDECL(saveinfo_num, (unsigned char *, unsigned, int,
+                                         long));
 #ifdef MFLOPPY
 STATIC_DCL void FDECL(savelev0, (int, XCHAR_P, int));
 STATIC_DCL boolean NDECL(swapout_oldest);
@@ -41,6 +79,7 @@ STATIC_DCL void FDECL(def_bufon, (int));
 STATIC_DCL void FDECL(def_bufoff, (int));
 STATIC_DCL void FDECL(def_bflush, (int));
 STATIC_DCL void FDECL(def_bwrite, (int, genericptr_t, unsigned int));
+STATIC_DCL int FDECL(rawwrite, (int, genericptr_t, unsigned));
 #ifdef ZEROCOMP
 STATIC_DCL void FDECL(zerocomp_bufon, (int));
 STATIC_DCL void FDECL(zerocomp_bufoff, (int));
@@ -48,6 +87,17 @@ STATIC_DCL void FDECL(zerocomp_bflush, (int));
 STATIC_DCL void FDECL(zerocomp_bwrite, (int, genericptr_t, unsigned int));
 STATIC_DCL void FDECL(zerocomp_bputc, (int));
 #endif
+#ifdef LZCOMP
+STATIC_DCL void FDECL(lzcomp_bufon, (int));
+STATIC_DCL void FDECL(lzcomp_bufoff, (int));
+STATIC_DCL void FDECL(lzcomp_bflush, (int));
+STATIC_DCL void FDECL(lzcomp_bwrite, (int, genericptr_t, unsigned int));
+STATIC_DCL unsigned FDECL(lz_token, (unsigned char *, unsigned,
+                                     const unsigned char *, unsigned,
+                                     unsigned, unsigned));
+STATIC_DCL unsigned FDECL(lz_pack, (const unsigned char *, unsigned,
+                                    unsigned char *));
+#endif
 
 static struct save_procs {
     const char *name;
@@ -109,6 +159,7 @@ dosave0()
     xchar ltmp;
     d_level uz_save;
     char whynot[BUFSZ];
+    struct save_summary ss;
 
     /* we may get here via hangup signal, in which case we want to fix up
        a few of things before saving so that they won't be restored in
@@ -211,6 +262,8 @@ dosave0()
     store_version(fd);
     store_savefileinfo(fd);
     store_plname_in_file(fd);
+    fill_save_summary(&ss);
+    store_saveinfo(fd, &ss);
     ustuck_id = (u.ustuck ? u.ustuck->m_id : 0);
     usteed_id = (u.usteed ? u.usteed->m_id : 0);
     savelev(fd, ledger_no(&u.uz), WRITE_SAVE | FREE_SAVE);
@@ -269,6 +322,7 @@ dosave0()
     delete_levelfile(ledger_no(&u.uz));
     delete_levelfile(0);
     nh_compress(fq_save);
+    update_saveindex(&ss);
     /* this should probably come sooner... */
     program_state.something_worth_saving = 0;
     return 1;
@@ -284,6 +338,7 @@ register int fd, mode;
     count_only = (mode & COUNT_SAVE);
 #endif
     uid = (unsigned long) getuid();
+    save_chunk(fd, mode, SC_GAME);
     bwrite(fd, (genericptr_t) &uid, sizeof uid);
     bwrite(fd, (genericptr_t) &context, sizeof(struct context_info));
     bwrite(fd, (genericptr_t) &flags, sizeof(struct flag));
@@ -293,18 +348,23 @@ register int fd, mode;
     urealtime.finish_time = getnow();
     urealtime.realtime += (long) (urealtime.finish_time
                                   - urealtime.start_timing);
+    save_chunk(fd, mode, SC_HERO);
     bwrite(fd, (genericptr_t) &u, sizeof(struct you));
     bwrite(fd, yyyymmddhhmmss(ubirthday), 14);
     bwrite(fd, (genericptr_t) &urealtime.realtime, sizeof urealtime.realtime);
     bwrite(fd, yyyymmddhhmmss(urealtime.start_timing), 14);  /** Why? **/
     /* this is the value to use for the next update of urealtime.realtime */
     urealtime.start_timing = urealtime.finish_time;
+    save_chunk(fd, mode, SC_KILR);
     save_killers(fd, mode);
 
     /* must come before migrating_objs and migrating_mons are freed */
+    save_chunk(fd, mode, SC_TIMR);
     save_timers(fd, mode, RANGE_GLOBAL);
+    save_chunk(fd, mode, SC_LITE);
     save_light_sources(fd, mode, RANGE_GLOBAL);
 
+    save_chunk(fd, mode, SC_INVT);
     saveobjchn(fd, invent, mode);
     if (BALL_IN_MON) {
         /* prevent loss of ball & chain when swallowed */
@@ -315,6 +375,7 @@ register int fd, mode;
         saveobjchn(fd, (struct obj *) 0, mode);
     }
 
+    save_chunk(fd, mode, SC_MIGR);
     saveobjchn(fd, migrating_objs, mode);
     savemonchn(fd, migrating_mons, mode);
     if (release_data(mode)) {
@@ -322,27 +383,40 @@ register int fd, mode;
         migrating_objs = 0;
         migrating_mons = 0;
     }
+    save_chunk(fd, mode, SC_VITL);
     bwrite(fd, (genericptr_t) mvitals, sizeof(mvitals));
 
+    save_chunk(fd, mode, SC_DUNG);
     save_dungeon(fd, (boolean) !!perform_bwrite(mode),
                  (boolean) !!release_data(mode));
+    save_chunk(fd, mode, SC_LVCH);
     savelevchn(fd, mode);
+    save_chunk(fd, mode, SC_MISC);
     bwrite(fd, (genericptr_t) &moves, sizeof moves);
     bwrite(fd, (genericptr_t) &monstermoves, sizeof monstermoves);
     bwrite(fd, (genericptr_t) &quest_status, sizeof(struct q_score));
     bwrite(fd, (genericptr_t) spl_book,
            sizeof(struct spell) * (MAXSPELL + 1));
+    save_chunk(fd, mode, SC_ARTI);
     save_artifacts(fd);
+    save_chunk(fd, mode, SC_ORCL);
     save_oracles(fd, mode);
+    save_chunk(fd, mode, SC_PLAY);
     if (ustuck_id)
         bwrite(fd, (genericptr_t) &ustuck_id, sizeof ustuck_id);
     if (usteed_id)
         bwrite(fd, (genericptr_t) &usteed_id, sizeof usteed_id);
     bwrite(fd, (genericptr_t) pl_character, sizeof pl_character);
     bwrite(fd, (genericptr_t) pl_fruit, sizeof pl_fruit);
+    save_chunk(fd, mode, SC_FRUT);
     savefruitchn(fd, mode);
+    save_chunk(fd, mode, SC_NAME);
     savenames(fd, mode);
+    save_chunk(fd, mode, SC_WATR);
     save_waterlevel(fd, mode);
+    save_chunk(fd, mode, SC_RNGS);
+    save_rng(fd, mode);
+    save_chunk(fd, mode, SC_MSGH);
     save_msghistory(fd, mode);
     bflush(fd);
 }
@@ -409,11 +483,12 @@ savestateinlock()
             done(TRICKED);
             return;
         }
-        (void) write(fd, (genericptr_t) &hackpid, sizeof(hackpid));
+        /* bwrite() before bufon() uses plain write() */
+        bwrite(fd, (genericptr_t) &hackpid, sizeof(hackpid));
         if (flags.ins_chkpt) {
             int currlev = ledger_no(&u.uz);
 
-            (void) write(fd, (genericptr_t) &currlev, sizeof(currlev));
+            bwrite(fd, (genericptr_t) &currlev, sizeof(currlev));
             save_savefile_name(fd);
             store_version(fd);
             store_savefileinfo(fd);
@@ -494,6 +569,7 @@ int mode;
 #endif
     if (lev >= 0 && lev <= maxledgerno())
         level_info[lev].flags |= VISITED;
+    save_chunk(fd, mode, SC_LEVL);
     bwrite(fd, (genericptr_t) &hackpid, sizeof(hackpid));
 #ifdef TOS
     tlev = lev;
@@ -524,12 +600,17 @@ skip_lots:
     if (mode == FREE_SAVE)
         savecemetery(fd, mode, &level.bonesinfo);
     /* must be saved before mons, objs, and buried objs */
+    save_chunk(fd, mode, SC_TIMR);
     save_timers(fd, mode, RANGE_LEVEL);
+    save_chunk(fd, mode, SC_LITE);
     save_light_sources(fd, mode, RANGE_LEVEL);
 
+    save_chunk(fd, mode, SC_MONS);
     savemonchn(fd, fmon, mode);
     save_worm(fd, mode); /* save worm information */
+    save_chunk(fd, mode, SC_TRAP);
     savetrapchn(fd, ftrap, mode);
+    save_chunk(fd, mode, SC_OBJS);
     saveobjchn(fd, fobj, mode);
     saveobjchn(fd, level.buriedobjlist, mode);
     saveobjchn(fd, billobjs, mode);
@@ -541,8 +622,11 @@ skip_lots:
         billobjs = 0;
         /* level.bonesinfo = 0; -- handled by savecemetery() */
     }
+    save_chunk(fd, mode, SC_ENGR);
     save_engravings(fd, mode);
+    save_chunk(fd, mode, SC_DAMG);
     savedamage(fd, mode);
+    save_chunk(fd, mode, SC_REGN);
     save_regions(fd, mode);
     if (mode != FREE_SAVE)
         bflush(fd);
@@ -653,10 +737,71 @@ static int bw_fd = -1;
 static FILE *bw_FILE = 0;
 static boolean buffering = FALSE;
 
+/* memory image collecting everything written to bw_mem.fd */
+static struct {
+    int fd;
+    char *data;
+    unsigned len, size;
+} bw_mem = { -1, (char *) 0, 0, 0 };
+
+/* start collecting writes to fd in memory instead of passing them on */
+void
+bwrite_image(fd)
+int fd;
+{
+    if (bw_mem.data)
+        free((genericptr_t) bw_mem.data);
+    bw_mem.fd = fd;
+    bw_mem.size = 16 * BUFSZ;
+    bw_mem.data = (char *) alloc(bw_mem.size);
+    bw_mem.len = 0;
+}
+
+/* stop collecting; caller gets ownership of the collected bytes */
+char *
+bwrite_image_done(lenp)
+unsigned *lenp;
+{
+    char *data = bw_mem.data;
+
+    *lenp = bw_mem.len;
+    bw_mem.fd = -1;
+    bw_mem.data = (char *) 0;
+    bw_mem.len = bw_mem.size = 0;
+    return data;
+}
+
+/* lowest level of bwrite(): write() to fd or append to its memory image */
+STATIC_OVL int
+rawwrite(fd, loc, num)
+int fd;
+genericptr_t loc;
+unsigned num;
+{
+    if (fd < 0 || fd != bw_mem.fd)
+        return (int) write(fd, loc, num);
+    if (bw_mem.len + num > bw_mem.size) {
+        char *newdata;
+
+        while (bw_mem.len + num > bw_mem.size)
+            bw_mem.size *= 2;
+        newdata = (char *) alloc(bw_mem.size);
+        (void) memcpy((genericptr_t) newdata, (genericptr_t) bw_mem.data,
+                      bw_mem.len);
+        free((genericptr_t) bw_mem.data);
+        bw_mem.data = newdata;
+    }
+    (void) memcpy((genericptr_t) (bw_mem.data + bw_mem.len), loc, num);
+    bw_mem.len += num;
+    return (int) num;
+}
+
 STATIC_OVL void
 def_bufon(fd)
 int fd;
 {
+    if (fd == bw_mem.fd)
+        return; /* memory image is its own buffer */
 #ifdef UNIX
     if (bw_fd != fd) {
         if (bw_fd >= 0)
@@ -714,11 +859,7 @@ register unsigned num;
 #endif /* UNIX */
     {
         /* lint wants 3rd arg of write to be an int; lint -p an unsigned */
-#if defined(BSD) || defined(ULTRIX) || defined(WIN32) || defined(_MSC_VER)
-        failed = ((long) write(fd, loc, (int) num) != (long) num);
-#else /* e.g. SYSV, __TURBOC__ */
-        failed = ((long) write(fd, loc, num) != (long) num);
-#endif
+        failed = ((long) rawwrite(fd, loc, num) != (long) num);
     }
 
     if (failed) {
@@ -783,7 +924,7 @@ int c;
         return;
 #endif
     if (outbufp >= sizeof outbuf) {
-        (void) write(bwritefd, outbuf, sizeof outbuf);
+        (void) rawwrite(bwritefd, (genericptr_t) outbuf, sizeof outbuf);
         outbufp = 0;
     }
     outbuf[outbufp++] = (unsigned char) c;
@@ -827,7 +968,7 @@ register int fd;
 #endif
 
     if (outbufp) {
-        if (write(fd, outbuf, outbufp) != outbufp) {
+        if (rawwrite(fd, (genericptr_t) outbuf, outbufp) != outbufp) {
 #if defined(UNIX) || defined(VMS) || defined(__EMX__)
             if (program_state.done_hup)
                 nh_terminate(EXIT_FAILURE);
@@ -853,7 +994,7 @@ register unsigned num;
         if (count_only)
             return;
 #endif
-        if ((unsigned) write(fd, loc, num) != num) {
+        if ((unsigned) rawwrite(fd, loc, num) != num) {
 #if defined(UNIX) || defined(VMS) || defined(__EMX__)
             if (program_state.done_hup)
                 nh_terminate(EXIT_FAILURE);
@@ -888,6 +1029,206 @@ int fd;
 }
 #endif /* ZEROCOMP */
 
+#ifdef LZCOMP
+/*
+ * LZ block compression.  Once bufon() has been called, data is gathered
+ * into blocks of up to LZBLOCKSZ bytes.  Each block is written as a four
+ * byte header (unpacked length and packed length, 16 bits little-endian
+ * each) followed by the packed data, or by the data itself when packing
+ * didn't make it any smaller (packed length == unpacked length).
+ *
+ * Packed data is a series of sequences, each a token byte whose high
+ * nibble is the count of literal bytes and low nibble the match length
+ * less LZMINMATCH, a nibble of 15 being extended by further bytes which
+ * are added to it until one is below 255; then the literals; then the
+ * match's 16 bit offset back from the current position.  The last
+ * sequence of a block consists of literals only.
+ */
+#define LZHASHBITS 12
+#define LZHASH(p)                                                       \
+    ((unsigned) (((((unsigned long) (p)[0]) | ((unsigned long) (p)[1] << 8) \
+                   | ((unsigned long) (p)[2] << 16)                     \
+                   | ((unsigned long) (p)[3] << 24))                    \
+                  * 2654435761UL) & 0xffffffffUL) >> (32 - LZHASHBITS))
+
+static NEARDATA unsigned char lz_inbuf[LZBLOCKSZ];
+static NEARDATA unsigned char lz_outbuf[4 + LZBLOCKSZ + LZBLOCKSZ / 255 + 16];
+static NEARDATA unsigned short lz_hashtab[1 << LZHASHBITS];
+static NEARDATA unsigned lz_inlen = 0;
+static NEARDATA int lz_fd = -1;
+static NEARDATA boolean lz_compressing = FALSE;
+
+/* append one sequence to dst[op]; returns the new output position */
+STATIC_OVL unsigned
+lz_token(dst, op, lit, litlen, mlen, off)
+unsigned char *dst;
+unsigned op;
+const unsigned char *lit;
+unsigned litlen, mlen, off;
+{
+    unsigned char *tok = &dst[op++];
+    unsigned n;
+
+    *tok = (unsigned char) ((litlen < 15 ? litlen : 15) << 4);
+    if (litlen >= 15) {
+        for (n = litlen - 15; n >= 255; n -= 255)
+            dst[op++] = 255;
+        dst[op++] = (unsigned char) n;
+    }
+    (void) memcpy((genericptr_t) &dst[op], (genericptr_t) lit, litlen);
+    op += litlen;
+    if (mlen) {
+        dst[op++] = (unsigned char) (off & 0xff);
+        dst[op++] = (unsigned char) (off >> 8);
+        n = mlen - LZMINMATCH;
+        *tok |= (unsigned char) (n < 15 ? n : 15);
+        if (n >= 15) {
+            for (n -= 15; n >= 255; n -= 255)
+                dst[op++] = 255;
+            dst[op++] = (unsigned char) n;
+        }
+    }
+    return op;
+}
+
+/* pack srclen bytes of src into dst; returns the packed length */
+STATIC_OVL unsigned
+lz_pack(src, srclen, dst)
+const unsigned char *src;
+unsigned srclen;
+unsigned char *dst;
+{
+    unsigned ip = 0, anchor = 0, op = 0, ref, h, mlen;
+
+    /* positions are stored plus one so that zero means none */
+    (void) memset((genericptr_t) lz_hashtab, 0, sizeof lz_hashtab);
+    while (ip + LZMINMATCH <= srclen) {
+        h = LZHASH(&src[ip]);
+        ref = lz_hashtab[h];
+        lz_hashtab[h] = (unsigned short) (ip + 1);
+        if (!ref || memcmp((genericptr_t) &src[ref - 1],
+                           (genericptr_t) &src[ip], LZMINMATCH)) {
+            ip++;
+            continue;
+        }
+        ref--;
+        for (mlen = LZMINMATCH;
+             ip + mlen < srclen && src[ref + mlen] == src[ip + mlen]; mlen++)
+            continue;
+        op = lz_token(dst, op, &src[anchor], ip - anchor, mlen, ip - ref);
+        ip += mlen;
+        anchor = ip;
+    }
+    return lz_token(dst, op, &src[anchor], srclen - anchor, 0, 0);
+}
+
+/* write out whatever has been gathered so far as one block */
+STATIC_OVL void
+lzcomp_bflush(fd)
+int fd;
+{
+    unsigned plen, total;
+
+    nhUse(fd);
+    if (!lz_inlen)
+        return;
+#ifdef MFLOPPY
+    if (count_only) {
+        bytes_counted += lz_inlen; /* upper bound */
+        lz_inlen = 0;
+        return;
+    }
+#endif
+    plen = lz_pack(lz_inbuf, lz_inlen, &lz_outbuf[4]);
+    if (plen >= lz_inlen) {
+        plen = lz_inlen;
+        (void) memcpy((genericptr_t) &lz_outbuf[4], (genericptr_t) lz_inbuf,
+                      plen);
+    }
+    lz_outbuf[0] = (unsigned char) (lz_inlen & 0xff);
+    lz_outbuf[1] = (unsigned char) (lz_inlen >> 8);
+    lz_outbuf[2] = (unsigned char) (plen & 0xff);
+    lz_outbuf[3] = (unsigned char) (plen >> 8);
+    total = plen + 4;
+    lz_inlen = 0;
+    if ((unsigned) rawwrite(lz_fd, (genericptr_t) lz_outbuf, total)
+        != total) {
+#if defined(UNIX) || defined(VMS) || defined(__EMX__)
+        if (program_state.done_hup)
+            nh_terminate(EXIT_FAILURE);
+        else
+#endif
+            panic("cannot write %u bytes to file #%d", total, lz_fd);
+    }
+}
+
+/*ARGSUSED*/
+STATIC_OVL void
+lzcomp_bufon(fd)
+int fd;
+{
+    nhUse(fd);
+    lz_compressing = TRUE;
+}
+
+STATIC_OVL void
+lzcomp_bufoff(fd)
+int fd;
+{
+    lzcomp_bflush(fd);
+    lz_compressing = FALSE;
+}
+
+STATIC_OVL void
+lzcomp_bwrite(fd, loc, num)
+int fd;
+genericptr_t loc;
+register unsigned num;
+{
+    const unsigned char *bp = (const unsigned char *) loc;
+    unsigned n;
+
+    if (!lz_compressing) {
+#ifdef MFLOPPY
+        bytes_counted += num;
+        if (count_only)
+            return;
+#endif
+        if ((unsigned) rawwrite(fd, loc, num) != num) {
+#if defined(UNIX) || defined(VMS) || defined(__EMX__)
+            if (program_state.done_hup)
+                nh_terminate(EXIT_FAILURE);
+            else
+#endif
+                panic("cannot write %u bytes to file #%d", num, fd);
+        }
+        return;
+    }
+    if (fd != lz_fd) {
+        lzcomp_bflush(lz_fd); /* finish off the other file's block */
+        lz_fd = fd;
+    }
+    while (num) {
+        n = min(num, LZBLOCKSZ - lz_inlen);
+        (void) memcpy((genericptr_t) &lz_inbuf[lz_inlen], (genericptr_t) bp,
+                      n);
+        lz_inlen += n, bp += n, num -= n;
+        if (lz_inlen == LZBLOCKSZ)
+            lzcomp_bflush(fd);
+    }
+}
+
+void
+lzcomp_bclose(fd)
+int fd;
+{
+    lzcomp_bufoff(fd);
+    if (fd == lz_fd)
+        lz_fd = -1;
+    (void) nhclose(fd);
+}
+#endif /* LZCOMP */
+
 STATIC_OVL void
 savelevchn(fd, mode)
 register int fd, mode;
@@ -1185,8 +1526,11 @@ int mode;
         trap2 = trap->ntrap;
         if (perform_bwrite(mode))
             bwrite(fd, (genericptr_t) trap, sizeof (struct trap));
-        if (release_data(mode))
+        if (release_data(mode)) {
+            if (level.traps[trap->tx][trap->ty] == trap)
+                remove_trap_at(trap->tx, trap->ty);
             dealloc_trap(trap);
+        }
         trap = trap2;
     }
     if (perform_bwrite(mode))
@@ -1234,29 +1578,140 @@ int fd;
     return;
 }
 
+/* append one game summary field to buf[pos]; return the new position */
+STATIC_OVL unsigned
+saveinfo_str(buf, pos, tag, str)
+unsigned char *buf;
+unsigned pos;
+int tag;
+const char *str;
+{
+    unsigned len = (unsigned) strlen(str);
+
+    if (len > 255)
+        len = 255;
+    buf[pos++] = (unsigned char) tag;
+    buf[pos++] = (unsigned char) len;
+    (void) memcpy((genericptr_t) &buf[pos], (genericptr_t) str, len);
+    return pos + len;
+}
+
+STATIC_OVL unsigned
+saveinfo_num(buf, pos, tag, num)
+unsigned char *buf;
+unsigned pos;
+int tag;
+long num;
+{
+    int i;
+
+    buf[pos++] = (unsigned char) tag;
+    buf[pos++] = 4;
+    for (i = 0; i < 4; i++)
+        buf[pos++] = (unsigned char) ((num >> (8 * i)) & 0xff);
+    return pos;
+}
+
+/* gather the game summary for the save file and the save index */
+void
+fill_save_summary(ss)
+struct save_summary *ss;
+{
+    (void) memset((genericptr_t) ss, 0, sizeof *ss);
+    (void) strncpy(ss->plname, plname, PL_NSIZ - 1);
+    Strcpy(ss->role, urole.filecode);
+    Strcpy(ss->race, urace.filecode);
+    Strcpy(ss->gender, genders[flags.female].filecode);
+    Strcpy(ss->align, aligns[1 - u.ualign.type].filecode);
+    ss->depth = (long) depth(&u.uz);
+    (void) strncpy(ss->dungeon, dungeons[u.uz.dnum].dname, BUFSZ - 1);
+    ss->moves = moves;
+    ss->ulevel = (long) u.ulevel;
+    ss->hp = (long) (Upolyd ? u.mh : u.uhp);
+    ss->hpmax = (long) (Upolyd ? u.mhmax : u.uhpmax);
+    ss->mode = wizard ? 'D' : discover ? 'X' : '\0';
+    ss->savetime = (long) getnow();
+}
+
+/* write the game summary (see global.h) that follows the player name */
+void
+store_saveinfo(fd, ss)
+int fd;
+struct save_summary *ss;
+{
+    unsigned char buf[1024];
+    unsigned pos = 8;
+    char mode[2];
+
+    pos = saveinfo_str(buf, pos, SI_PLNAME, ss->plname);
+    pos = saveinfo_str(buf, pos, SI_ROLE, ss->role);
+    pos = saveinfo_str(buf, pos, SI_RACE, ss->race);
+    pos = saveinfo_str(buf, pos, SI_GENDER, ss->gender);
+    pos = saveinfo_str(buf, pos, SI_ALIGN, ss->align);
+    pos = saveinfo_num(buf, pos, SI_DEPTH, ss->depth);
+    pos = saveinfo_str(buf, pos, SI_DUNGEON, ss->dungeon);
+    pos = saveinfo_num(buf, pos, SI_MOVES, ss->moves);
+    pos = saveinfo_num(buf, pos, SI_ULEVEL, ss->ulevel);
+    pos = saveinfo_num(buf, pos, SI_HP, ss->hp);
+    pos = saveinfo_num(buf, pos, SI_HPMAX, ss->hpmax);
+    if (ss->mode) {
+        mode[0] = ss->mode, mode[1] = '\0';
+        pos = saveinfo_str(buf, pos, SI_MODE, mode);
+    }
+    pos = saveinfo_num(buf, pos, SI_SAVETIME, ss->savetime);
+
+    buf[0] = 'N', buf[1] = 'H', buf[2] = 's', buf[3] = 'i';
+    buf[4] = SAVEINFO_VERSION & 0xff, buf[5] = SAVEINFO_VERSION >> 8;
+    buf[6] = (pos - 8) & 0xff, buf[7] = (pos - 8) >> 8;
+    bufoff(fd);
+    /* bwrite() before bufon() uses plain write() */
+    bwrite(fd, (genericptr_t) buf, pos);
+    bufon(fd);
+}
+
 STATIC_OVL void
 save_msghistory(fd, mode)
 int fd, mode;
 {
-    char *msg;
+    char *msg, *blk = 0;
     int msgcount = 0, msglen;
-    int minusone = -1;
+    int marker = MSGHIST_BLOCK;
+    unsigned blklen = 0, blksiz = 0;
     boolean init = TRUE;
 
     if (perform_bwrite(mode)) {
-        /* ask window port for each message in sequence */
+        /* ask window port for each message in sequence and pack them,
+           oldest first and each NUL terminated, into a single block */
         while ((msg = getmsghistory(init)) != 0) {
             init = FALSE;
             msglen = strlen(msg);
-            /* sanity: truncate if necessary (shouldn't happen);
-               no need to modify msg[] since terminator isn't written */
+            /* sanity: truncate if necessary (shouldn't happen) */
             if (msglen > BUFSZ - 1)
                 msglen = BUFSZ - 1;
-            bwrite(fd, (genericptr_t) &msglen, sizeof(msglen));
-            bwrite(fd, (genericptr_t) msg, msglen);
+            if (blklen + msglen + 1 > blksiz) {
+                char *oblk = blk;
+
+                blksiz = blksiz ? 2 * blksiz : 40 * BUFSZ;
+                blk = (char *) alloc(blksiz);
+                if (oblk) {
+                    (void) memcpy((genericptr_t) blk, (genericptr_t) oblk,
+                                  blklen);
+                    free((genericptr_t) oblk);
+                }
+            }
+            (void) memcpy((genericptr_t) (blk + blklen), (genericptr_t) msg,
+                          msglen);
+            blk[blklen + msglen] = '\0';
+            blklen += msglen + 1;
             ++msgcount;
         }
-        bwrite(fd, (genericptr_t) &minusone, sizeof(int));
+        bwrite(fd, (genericptr_t) &marker, sizeof marker);
+        bwrite(fd, (genericptr_t) &msgcount, sizeof msgcount);
+        bwrite(fd, (genericptr_t) &blklen, sizeof blklen);
+        if (blklen)
+            bwrite(fd, (genericptr_t) blk, blklen);
+        if (blk)
+            free((genericptr_t) blk);
     }
     debugpline1("Stored %d messages into savefile.", msgcount);
     /* note: we don't attempt to handle release_data() here */
@@ -1281,10 +1736,43 @@ int fd;
     bufoff(fd);
     /* bwrite() before bufon() uses plain write() */
     bwrite(fd, (genericptr_t) &sfsaveinfo, (unsigned) (sizeof sfsaveinfo));
+    if ((sfsaveinfo.sfi2 & SFI2_CHUNKS) != 0)
+        store_chunktoc(fd);
     bufon(fd);
     return;
 }
 
+/* write the table of contents that follows the savefile info */
+STATIC_OVL void
+store_chunktoc(fd)
+int fd;
+{
+    unsigned char buf[6 + NUM_SAVE_CHUNKS * CHUNKTOC_ENTSZ], *p;
+    const struct save_chunk *sc;
+    int i;
+
+    buf[0] = 'N', buf[1] = 'H', buf[2] = 't', buf[3] = 'c';
+    buf[4] = NUM_SAVE_CHUNKS & 0xff, buf[5] = NUM_SAVE_CHUNKS >> 8;
+    for (p = &buf[6], sc = save_chunks; sc < &save_chunks[NUM_SAVE_CHUNKS];
+         sc++) {
+        for (i = 0; i < 4; i++)
+            *p++ = (unsigned char) sc->tag[i];
+        for (i = 0; i < 4; i++)
+            *p++ = (unsigned char) ((sc->size >> (8 * i)) & 0xff);
+    }
+    bwrite(fd, (genericptr_t) buf, (unsigned) sizeof buf);
+}
+
+/* mark the start of a chunk of saved data (see lev.h) */
+void
+save_chunk(fd, mode, which)
+int fd, mode, which;
+{
+    if (!perform_bwrite(mode) || (sfsaveinfo.sfi2 & SFI2_CHUNKS) == 0)
+        return;
+    bwrite(fd, (genericptr_t) save_chunks[which].tag, 4);
+}
+
 void
 set_savepref(suitename)
 const char *suitename;
@@ -1297,7 +1785,7 @@ const char *suitename;
         saveprocs.save_bwrite = def_bwrite;
         saveprocs.save_bclose = def_bclose;
         sfsaveinfo.sfi1 |= SFI1_EXTERNALCOMP;
-        sfsaveinfo.sfi1 &= ~SFI1_ZEROCOMP;
+        sfsaveinfo.sfi1 &= ~(SFI1_ZEROCOMP | SFI1_LZCOMP | SFI1_LZVERSMASK);
     }
     if (!strcmpi(suitename, "!rlecomp")) {
         sfsaveinfo.sfi1 &= ~SFI1_RLECOMP;
@@ -1311,7 +1799,21 @@ const char *suitename;
         saveprocs.save_bwrite = zerocomp_bwrite;
         saveprocs.save_bclose = zerocomp_bclose;
         sfsaveinfo.sfi1 |= SFI1_ZEROCOMP;
-        sfsaveinfo.sfi1 &= ~SFI1_EXTERNALCOMP;
+        sfsaveinfo.sfi1 &= ~(SFI1_EXTERNALCOMP | SFI1_LZCOMP
+                             | SFI1_LZVERSMASK);
+    }
+#endif
+#ifdef LZCOMP
+    if (!strcmpi(suitename, "lzcomp")) {
+        saveprocs.name = "lzcomp";
+        saveprocs.save_bufon = lzcomp_bufon;
+        saveprocs.save_bufoff = lzcomp_bufoff;
+        saveprocs.save_bflush = lzcomp_bflush;
+        saveprocs.save_bwrite = lzcomp_bwrite;
+        saveprocs.save_bclose = lzcomp_bclose;
+        sfsaveinfo.sfi1 &= ~(SFI1_EXTERNALCOMP | SFI1_ZEROCOMP
+                             | SFI1_LZVERSMASK);
+        sfsaveinfo.sfi1 |= SFI1_LZCOMP | SFI1_LZVERSION(LZCOMP_VERSION);
     }
 #endif
 #ifdef RLECOMP
@@ -1339,6 +1841,7 @@ freedynamicdata()
     free_maildata();
 #endif
     unload_qtlist();
+    free_levelimages();
     free_menu_coloring();
     free_invbuf();           /* let_to_name (invent.c) */
     free_youbuf();           /* You_buf,&c (pline.c) */
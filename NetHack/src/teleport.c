@@ -306,7 +306,7 @@ boolean allow_drag;
             ball_active = TRUE;
             allow_drag = FALSE;
         }
-        docrt();
+        refresh_map();
     }
     if (ball_active) {
         if (ball_still_in_range || allow_drag) {
@@ -1014,7 +1014,7 @@ register int x, y;
         if (u.uswallow) {
             u.ux = x;
             u.uy = y;
-            docrt();
+            refresh_map();
         } else
             u.ustuck = 0;
     }
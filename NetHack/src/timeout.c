@@ -1507,7 +1507,7 @@ do_storms()
  *      Start a timer of kind 'kind' that will expire at time
  *      monstermoves+'timeout'.  Call the function at 'func_index'
  *      in the timeout table using argument 'arg'.  Return TRUE if
- *      a timer was started.  This places the timer on a list ordered
+ *      a timer was started.  This places the timer in a queue ordered
  *      "sooner" to "later".  If an object, increment the object's
  *      timer count.
  *
@@ -1553,18 +1553,48 @@ do_storms()
  *      Check whether object has a timer of type timer_type.
  */
 
+/*
+ * Active timers are kept in a binary heap ordered by when they go off,
+ * so the next one due is always timer_heap[0].  Each is also chained,
+ * through its 'next' field, into a hash table keyed by its argument so
+ * that the timers of an object or spot can be found without looking at
+ * all of them.  Only the timer_element part of a timer_node is saved.
+ */
+typedef struct tnode {
+    timer_element te;  /* must be first */
+    int hpos;          /* index in timer_heap[] */
+    unsigned long seq; /* insertion order, for breaking ties */
+} timer_node;
+
+#define TNODE(t) ((timer_node *) (t))
+
 STATIC_DCL const char *FDECL(kind_name, (SHORT_P));
-STATIC_DCL void FDECL(print_queue, (winid, timer_element *));
+STATIC_DCL void FDECL(print_queue, (winid));
+STATIC_DCL boolean FDECL(timer_before, (timer_node *, timer_node *));
+STATIC_DCL int FDECL(CFDECLSPEC timer_cmp, (const genericptr,
+                                            const genericptr));
+STATIC_DCL timer_node **NDECL(sorted_timers);
+STATIC_DCL int FDECL(sift_up, (int));
+STATIC_DCL void FDECL(sift_down, (int));
+STATIC_DCL unsigned FDECL(timer_hashval, (anything *));
+STATIC_DCL void FDECL(rehash_timers, (unsigned));
+STATIC_DCL void FDECL(hash_timer, (timer_element *));
+STATIC_DCL void FDECL(unhash_timer, (timer_element *));
+STATIC_DCL timer_element *FDECL(match_timer, (int, int, anything *));
 STATIC_DCL void FDECL(insert_timer, (timer_element *));
-STATIC_DCL timer_element *FDECL(remove_timer,
-                                (timer_element **, SHORT_P, ANY_P *));
+STATIC_DCL void FDECL(detach_timer, (timer_element *));
+STATIC_DCL timer_element *FDECL(remove_timer, (SHORT_P, ANY_P *));
 STATIC_DCL void FDECL(write_timer, (int, timer_element *));
 STATIC_DCL boolean FDECL(mon_is_local, (struct monst *));
 STATIC_DCL boolean FDECL(timer_is_local, (timer_element *));
 STATIC_DCL int FDECL(maybe_write_timer, (int, int, BOOLEAN_P));
 
-/* ordered timer list */
-static timer_element *timer_base; /* "active" */
+/* timer queue */
+static timer_node **timer_heap = 0; /* "active" */
+static int n_timers = 0, max_timers = 0;
+static timer_element **timer_hash = 0;
+static unsigned timer_hashsz = 0; /* a power of two */
+static unsigned long timer_seq = 0;
 static unsigned long timer_id = 1;
 
 /* If defined, then include names when printing out the timer queue */
@@ -1616,18 +1646,21 @@ short kind;
 }
 
 STATIC_OVL void
-print_queue(win, base)
+print_queue(win)
 winid win;
-timer_element *base;
 {
+    timer_node **tlist;
     timer_element *curr;
     char buf[BUFSZ];
+    int i;
 
-    if (!base) {
+    if (!n_timers) {
         putstr(win, 0, " <empty>");
     } else {
         putstr(win, 0, "timeout  id   kind   call");
-        for (curr = base; curr; curr = curr->next) {
+        tlist = sorted_timers();
+        for (i = 0; i < n_timers; i++) {
+            curr = &tlist[i]->te;
 #ifdef VERBOSE_TIMER
             Sprintf(buf, " %4ld   %4ld  %-6s %s(%s)", curr->timeout,
                     curr->tid, kind_name(curr->kind),
@@ -1640,6 +1673,7 @@ timer_element *base;
 #endif
             putstr(win, 0, buf);
         }
+        free((genericptr_t) tlist);
     }
 }
 
@@ -1661,7 +1695,7 @@ wiz_timeout_queue()
     putstr(win, 0, "");
     putstr(win, 0, "Active timeout queue:");
     putstr(win, 0, "");
-    print_queue(win, timer_base);
+    print_queue(win);
 
     /* Timed properies:
      * check every one; the majority can't obtain temporary timeouts in
@@ -1713,9 +1747,15 @@ void
 timer_sanity_check()
 {
     timer_element *curr;
+    int i;
 
     /* this should be much more complete */
-    for (curr = timer_base; curr; curr = curr->next)
+    for (i = 0; i < n_timers; i++) {
+        curr = &timer_heap[i]->te;
+        if (timer_heap[i]->hpos != i
+            || (i > 0 && timer_before(timer_heap[i],
+                                      timer_heap[(i - 1) / 2])))
+            pline("timer sanity: timer %ld out of place", curr->tid);
         if (curr->kind == TIMER_OBJECT) {
             struct obj *obj = curr->arg.a_obj;
 
@@ -1724,6 +1764,7 @@ timer_sanity_check()
                       fmt_ptr((genericptr_t) obj), curr->tid);
             }
         }
+    }
 }
 
 /*
@@ -1737,12 +1778,12 @@ run_timers()
 
     /*
      * Always use the first element.  Elements may be added or deleted at
-     * any time.  The list is ordered, we are done when the first element
+     * any time.  The queue is ordered, we are done when the first element
      * is in the future.
      */
-    while (timer_base && timer_base->timeout <= monstermoves) {
-        curr = timer_base;
-        timer_base = curr->next;
+    while (n_timers && timer_heap[0]->te.timeout <= monstermoves) {
+        curr = &timer_heap[0]->te;
+        detach_timer(curr);
 
         if (curr->kind == TIMER_OBJECT)
             (curr->arg.a_obj)->timed--;
@@ -1766,8 +1807,8 @@ anything *arg;
     if (func_index < 0 || func_index >= NUM_TIME_FUNCS)
         panic("start_timer");
 
-    gnu = (timer_element *) alloc(sizeof(timer_element));
-    (void) memset((genericptr_t)gnu, 0, sizeof(timer_element));
+    gnu = (timer_element *) alloc(sizeof(timer_node));
+    (void) memset((genericptr_t)gnu, 0, sizeof(timer_node));
     gnu->next = 0;
     gnu->tid = timer_id++;
     gnu->timeout = monstermoves + when;
@@ -1796,7 +1837,7 @@ anything *arg;
     timer_element *doomed;
     long timeout;
 
-    doomed = remove_timer(&timer_base, func_index, arg);
+    doomed = remove_timer(func_index, arg);
 
     if (doomed) {
         timeout = doomed->timeout;
@@ -1818,13 +1859,9 @@ peek_timer(type, arg)
 short type;
 anything *arg;
 {
-    timer_element *curr;
+    timer_element *curr = match_timer(-1, type, arg);
 
-    for (curr = timer_base; curr; curr = curr->next) {
-        if (curr->func_index == type && curr->arg.a_void == arg->a_void)
-            return curr->timeout;
-    }
-    return 0L;
+    return curr ? curr->timeout : 0L;
 }
 
 /*
@@ -1834,15 +1871,16 @@ void
 obj_move_timers(src, dest)
 struct obj *src, *dest;
 {
-    int count;
+    int count = 0;
     timer_element *curr;
 
-    for (count = 0, curr = timer_base; curr; curr = curr->next)
-        if (curr->kind == TIMER_OBJECT && curr->arg.a_obj == src) {
-            curr->arg.a_obj = dest;
-            dest->timed++;
-            count++;
-        }
+    while ((curr = match_timer(TIMER_OBJECT, -1, obj_to_any(src))) != 0) {
+        unhash_timer(curr);
+        curr->arg.a_obj = dest;
+        hash_timer(curr);
+        dest->timed++;
+        count++;
+    }
     if (count != src->timed)
         panic("obj_move_timers");
     src->timed = 0;
@@ -1855,15 +1893,22 @@ void
 obj_split_timers(src, dest)
 struct obj *src, *dest;
 {
-    timer_element *curr, *next_timer = 0;
+    timer_element *curr, **tlist;
+    int i, n = 0;
 
-    for (curr = timer_base; curr; curr = next_timer) {
-        next_timer = curr->next; /* things may be inserted */
-        if (curr->kind == TIMER_OBJECT && curr->arg.a_obj == src) {
-            (void) start_timer(curr->timeout - monstermoves, TIMER_OBJECT,
-                               curr->func_index, obj_to_any(dest));
-        }
-    }
+    if (!src->timed || !n_timers)
+        return;
+    /* collect them first; starting timers may rearrange the hash chains */
+    tlist = (timer_element **) alloc(src->timed * sizeof *tlist);
+    for (curr = timer_hash[timer_hashval(obj_to_any(src))]; curr;
+         curr = curr->next)
+        if (curr->kind == TIMER_OBJECT && curr->arg.a_obj == src
+            && n < src->timed)
+            tlist[n++] = curr;
+    for (i = 0; i < n; i++)
+        (void) start_timer(tlist[i]->timeout - monstermoves, TIMER_OBJECT,
+                           tlist[i]->func_index, obj_to_any(dest));
+    free((genericptr_t) tlist);
 }
 
 /*
@@ -1874,22 +1919,14 @@ void
 obj_stop_timers(obj)
 struct obj *obj;
 {
-    timer_element *curr, *prev, *next_timer = 0;
+    timer_element *curr;
 
-    for (prev = 0, curr = timer_base; curr; curr = next_timer) {
-        next_timer = curr->next;
-        if (curr->kind == TIMER_OBJECT && curr->arg.a_obj == obj) {
-            if (prev)
-                prev->next = curr->next;
-            else
-                timer_base = curr->next;
-            if (timeout_funcs[curr->func_index].cleanup)
-                (*timeout_funcs[curr->func_index].cleanup)(&curr->arg,
-                                                           curr->timeout);
-            free((genericptr_t) curr);
-        } else {
-            prev = curr;
-        }
+    while ((curr = match_timer(TIMER_OBJECT, -1, obj_to_any(obj))) != 0) {
+        detach_timer(curr);
+        if (timeout_funcs[curr->func_index].cleanup)
+            (*timeout_funcs[curr->func_index].cleanup)(&curr->arg,
+                                                       curr->timeout);
+        free((genericptr_t) curr);
     }
     obj->timed = 0;
 }
@@ -1916,24 +1953,16 @@ spot_stop_timers(x, y, func_index)
 xchar x, y;
 short func_index;
 {
-    timer_element *curr, *prev, *next_timer = 0;
+    timer_element *curr;
     long where = (((long) x << 16) | ((long) y));
 
-    for (prev = 0, curr = timer_base; curr; curr = next_timer) {
-        next_timer = curr->next;
-        if (curr->kind == TIMER_LEVEL && curr->func_index == func_index
-            && curr->arg.a_long == where) {
-            if (prev)
-                prev->next = curr->next;
-            else
-                timer_base = curr->next;
-            if (timeout_funcs[curr->func_index].cleanup)
-                (*timeout_funcs[curr->func_index].cleanup)(&curr->arg,
-                                                           curr->timeout);
-            free((genericptr_t) curr);
-        } else {
-            prev = curr;
-        }
+    while ((curr = match_timer(TIMER_LEVEL, func_index,
+                               long_to_any(where))) != 0) {
+        detach_timer(curr);
+        if (timeout_funcs[curr->func_index].cleanup)
+            (*timeout_funcs[curr->func_index].cleanup)(&curr->arg,
+                                                       curr->timeout);
+        free((genericptr_t) curr);
     }
 }
 
@@ -1949,12 +1978,8 @@ short func_index;
     timer_element *curr;
     long where = (((long) x << 16) | ((long) y));
 
-    for (curr = timer_base; curr; curr = curr->next) {
-        if (curr->kind == TIMER_LEVEL && curr->func_index == func_index
-            && curr->arg.a_long == where)
-            return curr->timeout;
-    }
-    return 0L;
+    curr = match_timer(TIMER_LEVEL, func_index, long_to_any(where));
+    return curr ? curr->timeout : 0L;
 }
 
 long
@@ -1966,43 +1991,214 @@ short func_index;
     return (expires > 0L) ? expires - monstermoves : 0L;
 }
 
+/* does timer a go off before timer b? */
+STATIC_OVL boolean
+timer_before(a, b)
+timer_node *a, *b;
+{
+    if (a->te.timeout != b->te.timeout)
+        return (boolean) (a->te.timeout < b->te.timeout);
+    /* of two due at once, the one started later goes first, as it did
+       when the queue was a sorted list */
+    return (boolean) (a->seq > b->seq);
+}
+
+STATIC_OVL int CFDECLSPEC
+timer_cmp(p1, p2)
+const genericptr p1;
+const genericptr p2;
+{
+    timer_node *a = *(timer_node **) p1, *b = *(timer_node **) p2;
+
+    return timer_before(a, b) ? -1 : timer_before(b, a) ? 1 : 0;
+}
+
+/* the active timers in the order they'll go off; caller frees */
+STATIC_OVL timer_node **
+sorted_timers()
+{
+    timer_node **tlist;
+
+    tlist = (timer_node **) alloc(max(n_timers, 1) * sizeof *tlist);
+    if (n_timers) {
+        (void) memcpy((genericptr_t) tlist, (genericptr_t) timer_heap,
+                      n_timers * sizeof *tlist);
+        qsort((genericptr_t) tlist, n_timers, sizeof *tlist, timer_cmp);
+    }
+    return tlist;
+}
+
+/* move the timer at heap index pos up to its place; returns where it
+   ends up */
+STATIC_OVL int
+sift_up(pos)
+int pos;
+{
+    timer_node *tn = timer_heap[pos];
+    int parent;
+
+    while (pos > 0 && timer_before(tn, timer_heap[parent = (pos - 1) / 2])) {
+        timer_heap[pos] = timer_heap[parent];
+        timer_heap[pos]->hpos = pos;
+        pos = parent;
+    }
+    timer_heap[pos] = tn;
+    tn->hpos = pos;
+    return pos;
+}
+
+/* move the timer at heap index pos down to its place */
+STATIC_OVL void
+sift_down(pos)
+int pos;
+{
+    timer_node *tn = timer_heap[pos];
+    int child;
+
+    while ((child = 2 * pos + 1) < n_timers) {
+        if (child + 1 < n_timers
+            && timer_before(timer_heap[child + 1], timer_heap[child]))
+            child++;
+        if (!timer_before(timer_heap[child], tn))
+            break;
+        timer_heap[pos] = timer_heap[child];
+        timer_heap[pos]->hpos = pos;
+        pos = child;
+    }
+    timer_heap[pos] = tn;
+    tn->hpos = pos;
+}
+
+STATIC_OVL unsigned
+timer_hashval(arg)
+anything *arg;
+{
+    unsigned long v = arg->a_ulong;
+
+    /* object pointers are aligned, spots are (x << 16) | y */
+    v ^= (v >> 16) ^ (v >> 5);
+    return (unsigned) v & (timer_hashsz - 1);
+}
+
+/* (re)build the hash chains with the given number of buckets */
+STATIC_OVL void
+rehash_timers(size)
+unsigned size;
+{
+    int i;
+
+    if (size != timer_hashsz) {
+        if (timer_hash)
+            free((genericptr_t) timer_hash);
+        timer_hash = (timer_element **) alloc(size * sizeof *timer_hash);
+        timer_hashsz = size;
+    }
+    (void) memset((genericptr_t) timer_hash, 0, size * sizeof *timer_hash);
+    for (i = 0; i < n_timers; i++)
+        hash_timer(&timer_heap[i]->te);
+}
+
+STATIC_OVL void
+hash_timer(curr)
+timer_element *curr;
+{
+    unsigned h = timer_hashval(&curr->arg);
+
+    curr->next = timer_hash[h];
+    timer_hash[h] = curr;
+}
+
+STATIC_OVL void
+unhash_timer(curr)
+timer_element *curr;
+{
+    timer_element **tp;
+
+    for (tp = &timer_hash[timer_hashval(&curr->arg)]; *tp; tp = &(*tp)->next)
+        if (*tp == curr) {
+            *tp = curr->next;
+            break;
+        }
+}
+
+/*
+ * Find the first timer to go off for arg; kind and func_index must match
+ * too unless they're -1.  Level timers compare arg as a long, the rest
+ * as a pointer.
+ */
+STATIC_OVL timer_element *
+match_timer(kind, func_index, arg)
+int kind, func_index;
+anything *arg;
+{
+    timer_element *curr, *found = 0;
+
+    if (!n_timers)
+        return (timer_element *) 0;
+    for (curr = timer_hash[timer_hashval(arg)]; curr; curr = curr->next) {
+        if ((kind >= 0 && curr->kind != kind)
+            || (func_index >= 0 && curr->func_index != func_index))
+            continue;
+        if ((kind == TIMER_LEVEL) ? (curr->arg.a_long != arg->a_long)
+                                  : (curr->arg.a_void != arg->a_void))
+            continue;
+        if (!found || timer_before(TNODE(curr), TNODE(found)))
+            found = curr;
+    }
+    return found;
+}
+
 /* Insert timer into the global queue */
 STATIC_OVL void
 insert_timer(gnu)
 timer_element *gnu;
 {
-    timer_element *curr, *prev;
+    timer_node *tn = TNODE(gnu), **tmp_heap;
+
+    if (n_timers >= max_timers) {
+        tmp_heap = timer_heap;
+        max_timers = max_timers ? 2 * max_timers : 64;
+        timer_heap = (timer_node **) alloc(max_timers * sizeof *timer_heap);
+        if (n_timers)
+            (void) memcpy((genericptr_t) timer_heap, (genericptr_t) tmp_heap,
+                          n_timers * sizeof *timer_heap);
+        if (tmp_heap)
+            free((genericptr_t) tmp_heap);
+    }
+    tn->seq = ++timer_seq;
+    timer_heap[n_timers] = tn;
+    (void) sift_up(n_timers++);
+    /* keep the chains short */
+    if ((unsigned) n_timers > 2 * timer_hashsz)
+        rehash_timers(timer_hashsz ? 4 * timer_hashsz : 64);
+    else
+        hash_timer(gnu);
+}
 
-    for (prev = 0, curr = timer_base; curr; prev = curr, curr = curr->next)
-        if (curr->timeout >= gnu->timeout)
-            break;
+/* take a timer out of the queue without freeing it */
+STATIC_OVL void
+detach_timer(curr)
+timer_element *curr;
+{
+    int pos = TNODE(curr)->hpos;
 
-    gnu->next = curr;
-    if (prev)
-        prev->next = gnu;
-    else
-        timer_base = gnu;
+    unhash_timer(curr);
+    if (pos != --n_timers) {
+        timer_heap[pos] = timer_heap[n_timers];
+        sift_down(sift_up(pos));
+    }
+    timer_heap[n_timers] = (timer_node *) 0;
 }
 
 STATIC_OVL timer_element *
-remove_timer(base, func_index, arg)
-timer_element **base;
+remove_timer(func_index, arg)
 short func_index;
 anything *arg;
 {
-    timer_element *prev, *curr;
-
-    for (prev = 0, curr = *base; curr; prev = curr, curr = curr->next)
-        if (curr->func_index == func_index && curr->arg.a_void == arg->a_void)
-            break;
-
-    if (curr) {
-        if (prev)
-            prev->next = curr->next;
-        else
-            *base = curr->next;
-    }
+    timer_element *curr = match_timer(-1, func_index, arg);
 
+    if (curr)
+        detach_timer(curr);
     return curr;
 }
 
@@ -2132,10 +2328,14 @@ maybe_write_timer(fd, range, write_it)
 int fd, range;
 boolean write_it;
 {
-    int count = 0;
+    int i, count = 0;
+    timer_node **tlist;
     timer_element *curr;
 
-    for (curr = timer_base; curr; curr = curr->next) {
+    /* write them in queue order so that ties restore the same way */
+    tlist = write_it ? sorted_timers() : timer_heap;
+    for (i = 0; i < n_timers; i++) {
+        curr = &tlist[i]->te;
         if (range == RANGE_GLOBAL) {
             /* global timers */
 
@@ -2155,6 +2355,8 @@ boolean write_it;
             }
         }
     }
+    if (write_it)
+        free((genericptr_t) tlist);
 
     return count;
 }
@@ -2176,8 +2378,8 @@ void
 save_timers(fd, mode, range)
 int fd, mode, range;
 {
-    timer_element *curr, *prev, *next_timer = 0;
-    int count;
+    timer_element *curr;
+    int i, j, count;
 
     if (perform_bwrite(mode)) {
         if (range == RANGE_GLOBAL)
@@ -2189,19 +2391,28 @@ int fd, mode, range;
     }
 
     if (release_data(mode)) {
-        for (prev = 0, curr = timer_base; curr; curr = next_timer) {
-            next_timer = curr->next; /* in case curr is removed */
-
-            if (!(!!(range == RANGE_LEVEL) ^ !!timer_is_local(curr))) {
-                if (prev)
-                    prev->next = curr->next;
-                else
-                    timer_base = curr->next;
+        for (i = j = 0; i < n_timers; i++) {
+            curr = &timer_heap[i]->te;
+            if (!(!!(range == RANGE_LEVEL) ^ !!timer_is_local(curr)))
                 free((genericptr_t) curr);
-                /* prev stays the same */
-            } else {
-                prev = curr;
-            }
+            else
+                timer_heap[j++] = timer_heap[i];
+        }
+        n_timers = j;
+        if (!n_timers) {
+            if (timer_heap)
+                free((genericptr_t) timer_heap);
+            if (timer_hash)
+                free((genericptr_t) timer_hash);
+            timer_heap = 0, max_timers = 0;
+            timer_hash = 0, timer_hashsz = 0;
+        } else {
+            /* rebuild the heap and hash chains from what's left */
+            for (i = n_timers / 2 - 1; i >= 0; i--)
+                sift_down(i);
+            for (i = 0; i < n_timers; i++)
+                timer_heap[i]->hpos = i;
+            rehash_timers(timer_hashsz);
         }
     }
 }
@@ -2225,7 +2436,7 @@ long adjust;     /* how much to adjust timeout */
     /* restore elements */
     mread(fd, (genericptr_t) &count, sizeof count);
     while (count-- > 0) {
-        curr = (timer_element *) alloc(sizeof(timer_element));
+        curr = (timer_element *) alloc(sizeof(timer_node));
         mread(fd, (genericptr_t) curr, sizeof(timer_element));
         if (ghostly)
             curr->timeout += adjust;
@@ -2240,14 +2451,11 @@ const char *hdrfmt;
 char *hdrbuf;
 long *count, *size;
 {
-    timer_element *te;
-
     Sprintf(hdrbuf, hdrfmt, (long) sizeof (timer_element));
-    *count = *size = 0L;
-    for (te = timer_base; te; te = te->next) {
-        ++*count;
-        *size += (long) sizeof *te;
-    }
+    *count = (long) n_timers;
+    *size = (long) n_timers * (long) sizeof (timer_node)
+            + (long) max_timers * (long) sizeof *timer_heap
+            + (long) timer_hashsz * (long) sizeof *timer_hash;
 }
 
 /* reset all timers that are marked for reseting */
@@ -2257,8 +2465,10 @@ boolean ghostly;
 {
     timer_element *curr;
     unsigned nid;
+    int i;
 
-    for (curr = timer_base; curr; curr = curr->next) {
+    for (i = 0; i < n_timers; i++) {
+        curr = &timer_heap[i]->te;
         if (curr->needs_fixup) {
             if (curr->kind == TIMER_OBJECT) {
                 if (ghostly) {
@@ -2276,6 +2486,52 @@ boolean ghostly;
                 panic("relink_timers 2");
         }
     }
+    /* the hash chains were built on ids rather than pointers */
+    if (n_timers)
+        rehash_timers(timer_hashsz);
+}
+
+/* #wizbench: start, look up and stop a large number of level timers */
+void
+timer_bench(win)
+winid win;
+{
+    char buf[BUFSZ];
+    unsigned long save_id = timer_id, save_seq = timer_seq, r = 1UL;
+    long t[3], i, j, n = 100000L, where;
+    int k;
+
+    for (k = 0; k < 3; k++) {
+        t[k] = cputime_ms();
+        for (i = 0; i < n; i++) {
+            /* spots are off the map so they can't collide with real ones;
+               they're stopped in the opposite order from being started */
+            j = (k == 2) ? n - 1 - i : i;
+            where = (((long) (COLNO + j / 256) << 16) | (j % 256));
+            switch (k) {
+            case 0:
+                /* an LCG, so the game's random numbers aren't disturbed;
+                   none of these is due for a long time */
+                r = r * 1103515245UL + 12345UL;
+                (void) start_timer(1000000L + (long) ((r >> 8) % 100000UL),
+                                   TIMER_LEVEL, MELT_ICE_AWAY,
+                                   long_to_any(where));
+                break;
+            case 1:
+                (void) peek_timer(MELT_ICE_AWAY, long_to_any(where));
+                break;
+            default:
+                (void) stop_timer(MELT_ICE_AWAY, long_to_any(where));
+                break;
+            }
+        }
+        t[k] = cputime_ms() - t[k];
+    }
+    timer_id = save_id, timer_seq = save_seq;
+
+    Sprintf(buf, "timers: %ld, start %ld ms, peek %ld ms, stop %ld ms", n,
+            t[0], t[1], t[2]);
+    putstr(win, 0, buf);
 }
 
 /*timeout.c*/
@@ -435,6 +435,7 @@ int x, y, typ;
     if (!oldplace) {
         ttmp->ntrap = ftrap;
         ftrap = ttmp;
+        place_trap_at(ttmp);
     } else {
         /* oldplace;
            it shouldn't be possible to override a sokoban pit or hole
@@ -4836,14 +4837,9 @@ struct trap *
 t_at(x, y)
 register int x, y;
 {
-    register struct trap *trap = ftrap;
-
-    while (trap) {
-        if (trap->tx == x && trap->ty == y)
-            return trap;
-        trap = trap->ntrap;
-    }
-    return (struct trap *) 0;
+    if (!isok(x, y))
+        return (struct trap *) 0;
+    return level.traps[x][y];
 }
 
 void
@@ -4863,11 +4859,47 @@ register struct trap *trap;
             panic("deltrap: no preceding trap!");
         ttmp->ntrap = trap->ntrap;
     }
+    if (level.traps[trap->tx][trap->ty] == trap)
+        remove_trap_at(trap->tx, trap->ty);
     if (Sokoban && (trap->ttyp == PIT || trap->ttyp == HOLE))
         maybe_finish_sokoban();
     dealloc_trap(trap);
 }
 
+/* support for wizard-mode's `sanity_check' option:
+   verify that level.traps[][] agrees with the ftrap chain */
+void
+trap_sanity_check()
+{
+    int x, y;
+    struct trap *ttmp, *t;
+
+    for (ttmp = ftrap; ttmp; ttmp = ttmp->ntrap) {
+        x = ttmp->tx, y = ttmp->ty;
+        if (!isok(x, y))
+            impossible("trap (%s) claims to be at <%d,%d>?",
+                       fmt_ptr((genericptr_t) ttmp), x, y);
+        else if (level.traps[x][y] != ttmp)
+            impossible("trap (%s) at <%d,%d> is not there!",
+                       fmt_ptr((genericptr_t) ttmp), x, y);
+    }
+
+    for (x = 0; x < COLNO; x++)
+        for (y = 0; y < ROWNO; y++)
+            if ((ttmp = level.traps[x][y]) != 0) {
+                for (t = ftrap; t; t = t->ntrap)
+                    if (t == ttmp)
+                        break;
+                if (!t)
+                    impossible("map trap (%s) at <%d,%d> not in ftrap list!",
+                               fmt_ptr((genericptr_t) ttmp), x, y);
+                else if (ttmp->tx != x || ttmp->ty != y)
+                    impossible("map trap (%s) at <%d,%d> is found at <%d,%d>?",
+                               fmt_ptr((genericptr_t) ttmp), ttmp->tx,
+                               ttmp->ty, x, y);
+            }
+}
+
 boolean
 conjoined_pits(trap2, trap1, u_entering_trap2)
 struct trap *trap2, *trap1;
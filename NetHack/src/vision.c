@@ -93,6 +93,30 @@ static char *viz_clear_rows[ROWNO];
 static char left_ptrs[ROWNO][COLNO]; /* LOS algorithm helpers */
 static char right_ptrs[ROWNO][COLNO];
 
+/*
+ * The hero's line of sight from the last vision_recalc(), before any
+ * lighting, night vision or xray bits were added.  Lines of sight to a
+ * row only cross the rows between it and the hero, so when the hero
+ * hasn't moved and block_point()/unblock_point() have only changed rows
+ * on one side of the hero, the other half of the view can be reused.
+ */
+#define VIEW_DOWN 0x1 /* rows below the hero (step > 0) */
+#define VIEW_UP 0x2   /* rows above the hero (step < 0) */
+#define VIEW_ALL (VIEW_DOWN | VIEW_UP)
+
+static struct {
+    char rows[ROWNO][COLNO]; /* COULD_SEE bits only */
+    xchar rmin[ROWNO], rmax[ROWNO];
+    xchar ux, uy;  /* where the hero was */
+    int dirty;     /* VIEW_xxx halves changed since then */
+    boolean valid;
+} los_cache;
+static int view_halves = VIEW_ALL; /* halves view_from() is to fill in */
+
+/* rows of line of sight recomputed, for #stats */
+static long los_rows_turn = 0L, los_rows_lastturn = 0L, los_turn = 0L;
+static long los_partial = 0L;
+
 /* Forward declarations. */
 STATIC_DCL void FDECL(fill_point, (int, int));
 STATIC_DCL void FDECL(dig_point, (int, int));
@@ -102,6 +126,10 @@ STATIC_DCL void FDECL(view_from, (int, int, char **, char *, char *, int,
                                   genericptr_t));
 STATIC_DCL void FDECL(get_unused_cs, (char ***, char **, char **));
 STATIC_DCL void FDECL(rogue_vision, (char **, char *, char *));
+STATIC_DCL void FDECL(hero_view, (char **, char *, char *));
+STATIC_DCL void FDECL(count_los_rows, (int));
+STATIC_DCL void FDECL(check_hero_view, (char **, char *, char *));
+STATIC_DCL void FDECL(los_changed, (int));
 
 /* Macro definitions that I can't find anywhere. */
 #define sign(z) ((z) < 0 ? -1 : ((z) ? 1 : 0))
@@ -134,6 +162,7 @@ vision_init()
 
     vision_full_recalc = 0;
     (void) memset((genericptr_t) could_see, 0, sizeof(could_see));
+    los_cache.valid = FALSE;
 
     /* Initialize the vision algorithm (currently C or D). */
     view_init();
@@ -205,6 +234,8 @@ vision_reset()
 
     /* Reset the pointers and clear so that we have a "full" dungeon. */
     (void) memset((genericptr_t) viz_clear, 0, sizeof(viz_clear));
+    light_block_changed(-1, -1);
+    los_cache.valid = FALSE;
 
     /* Dig the level */
     for (y = 0; y < ROWNO; y++) {
@@ -479,9 +510,9 @@ int row, col;
  *        impacted by vision occur during the same move [make_blinded()]
  *
  * Control flag = 1.  An adjacent vision recalculation.  The hero has moved
- * one square.  Knowing this, it might be possible to optimize the vision
- * recalculation using the current knowledge.  This is presently unimplemented
- * and is treated as a control = 0 call.
+ * one square.  Every line of sight now starts somewhere else, so this is
+ * treated as a control = 0 call.  (When the hero hasn't moved, hero_view()
+ * reuses whatever part of the line of sight is still valid.)
  *
  *      + Right after the hero moves. [domove()]
  *
@@ -546,9 +577,7 @@ int control;
          *
          *      + Monsters can see you even when you're in a pit.
          */
-        view_from(u.uy, u.ux, next_array, next_rmin, next_rmax, 0,
-                  (void FDECL((*), (int, int, genericptr_t))) 0,
-                  (genericptr_t) 0);
+        hero_view(next_array, next_rmin, next_rmax);
 
         /*
          * Our own version of the update loop below.  We know we can't see
@@ -611,9 +640,7 @@ int control;
                     next_row[col] = IN_SIGHT | COULD_SEE;
             }
         } else
-            view_from(u.uy, u.ux, next_array, next_rmin, next_rmax, 0,
-                      (void FDECL((*), (int, int, genericptr_t))) 0,
-                      (genericptr_t) 0);
+            hero_view(next_array, next_rmin, next_rmax);
 
         /*
          * Set the IN_SIGHT bit for xray and night vision.
@@ -835,6 +862,148 @@ skip:
     recalc_mapseen();
 }
 
+/*
+ * hero_view()
+ *
+ * Fill in the hero's line of sight for vision_recalc(), reusing the part
+ * of the last one that can't have changed.
+ */
+STATIC_OVL void
+hero_view(next_array, next_rmin, next_rmax)
+char **next_array;
+char *next_rmin, *next_rmax;
+{
+    int row, redo, lo, hi;
+    char *crow;
+
+    if (los_cache.valid && los_cache.ux == u.ux && los_cache.uy == u.uy)
+        redo = los_cache.dirty;
+    else
+        redo = VIEW_ALL;
+
+    if (redo) {
+        view_halves = redo;
+        view_from(u.uy, u.ux, next_array, next_rmin, next_rmax, 0,
+                  (void FDECL((*), (int, int, genericptr_t))) 0,
+                  (genericptr_t) 0);
+        view_halves = VIEW_ALL;
+    }
+
+    for (row = 0; row < ROWNO; row++) {
+        crow = los_cache.rows[row];
+        if ((row > u.uy && (redo & VIEW_DOWN))
+            || (row < u.uy && (redo & VIEW_UP))
+            || (row == u.uy && redo)) {
+            /* freshly computed; remember it */
+            lo = los_cache.rmin[row], hi = los_cache.rmax[row];
+            if (lo <= hi)
+                (void) memset((genericptr_t) &crow[lo], 0, hi - lo + 1);
+            lo = next_rmin[row], hi = next_rmax[row];
+            los_cache.rmin[row] = lo, los_cache.rmax[row] = hi;
+            if (lo <= hi)
+                (void) memcpy((genericptr_t) &crow[lo],
+                              (genericptr_t) &next_array[row][lo],
+                              hi - lo + 1);
+        } else {
+            /* still valid; next_array[] is all zero at this point */
+            lo = los_cache.rmin[row], hi = los_cache.rmax[row];
+            next_rmin[row] = lo, next_rmax[row] = hi;
+            if (lo <= hi)
+                (void) memcpy((genericptr_t) &next_array[row][lo],
+                              (genericptr_t) &crow[lo], hi - lo + 1);
+        }
+    }
+
+    if (redo != VIEW_ALL) {
+        los_partial++;
+        if (iflags.sanity_check)
+            check_hero_view(next_array, next_rmin, next_rmax);
+    }
+    count_los_rows((redo == VIEW_ALL) ? ROWNO
+                   : (redo == VIEW_DOWN) ? ROWNO - u.uy
+                     : (redo == VIEW_UP) ? u.uy + 1 : 0);
+    los_cache.ux = u.ux, los_cache.uy = u.uy;
+    los_cache.dirty = 0;
+    los_cache.valid = TRUE;
+}
+
+STATIC_OVL void
+count_los_rows(nrows)
+int nrows;
+{
+    if (los_turn != moves) {
+        los_rows_lastturn = (los_turn == moves - 1) ? los_rows_turn : 0L;
+        los_rows_turn = 0L;
+        los_turn = moves;
+    }
+    los_rows_turn += nrows;
+}
+
+/* sanity_check: compare a partly reused line of sight with a full one */
+STATIC_OVL void
+check_hero_view(next_array, next_rmin, next_rmax)
+char **next_array;
+char *next_rmin, *next_rmax;
+{
+    static char chk[ROWNO][COLNO];
+    char *chk_rows[ROWNO], chk_rmin[ROWNO], chk_rmax[ROWNO];
+    int row, col;
+
+    (void) memset((genericptr_t) chk, 0, sizeof chk);
+    for (row = 0; row < ROWNO; row++) {
+        chk_rows[row] = chk[row];
+        chk_rmin[row] = COLNO - 1;
+        chk_rmax[row] = 0;
+    }
+    view_from(u.uy, u.ux, chk_rows, chk_rmin, chk_rmax, 0,
+              (void FDECL((*), (int, int, genericptr_t))) 0,
+              (genericptr_t) 0);
+    for (row = 0; row < ROWNO; row++) {
+        if (chk_rmin[row] != next_rmin[row]
+            || chk_rmax[row] != next_rmax[row]
+            || memcmp((genericptr_t) chk[row], (genericptr_t) next_array[row],
+                      COLNO)) {
+            for (col = 0; col < COLNO - 1; col++)
+                if (chk[row][col] != next_array[row][col])
+                    break;
+            impossible("hero_view: reused line of sight differs at <%d,%d>",
+                       col, row);
+            los_cache.valid = FALSE;
+            return;
+        }
+    }
+}
+
+/* the map changed at row y; mark the half of the cached view it affects */
+STATIC_OVL void
+los_changed(y)
+int y;
+{
+    if (y > los_cache.uy)
+        los_cache.dirty |= VIEW_DOWN;
+    else if (y < los_cache.uy)
+        los_cache.dirty |= VIEW_UP;
+    else
+        los_cache.dirty = VIEW_ALL;
+}
+
+/* to support '#stats' wizard-mode command */
+void
+vision_stats(hdrfmt, hdrbuf, count, size)
+const char *hdrfmt;
+char *hdrbuf;
+long *count, *size;
+{
+    if (!los_cache.valid)
+        return; /* no line of sight cached yet (or on the Rogue level) */
+    /* the current turn isn't over yet, so report the one before it */
+    Sprintf(hdrbuf, hdrfmt,
+            (los_turn == moves) ? los_rows_lastturn
+            : (los_turn == moves - 1) ? los_rows_turn : 0L);
+    *count = los_partial;
+    *size = (long) sizeof los_cache;
+}
+
 /*
  * block_point()
  *
@@ -845,8 +1014,8 @@ block_point(x, y)
 int x, y;
 {
     fill_point(y, x);
-
-    /* recalc light sources here? */
+    los_changed(y);
+    light_block_changed(x, y);
 
     /*
      * We have to do a full vision recalculation if we "could see" the
@@ -869,8 +1038,8 @@ unblock_point(x, y)
 int x, y;
 {
     dig_point(y, x);
-
-    /* recalc light sources here? */
+    los_changed(y);
+    light_block_changed(x, y);
 
     if (viz_array[y][x])
         vision_full_recalc = 1;
@@ -2269,7 +2438,7 @@ genericptr_t arg;
     /*
      *  Check what could be seen in quadrants.
      */
-    if ((nrow = srow + 1) < ROWNO) {
+    if ((view_halves & VIEW_DOWN) && (nrow = srow + 1) < ROWNO) {
         step = 1; /* move down */
         if (scol < COLNO - 1)
             right_side(nrow, -1, scol, right_row, right, scol, right, limits);
@@ -2277,7 +2446,7 @@ genericptr_t arg;
             left_side(nrow, -1, scol, left_row, left, left, scol, limits);
     }
 
-    if ((nrow = srow - 1) >= 0) {
+    if ((view_halves & VIEW_UP) && (nrow = srow - 1) >= 0) {
         step = -1; /* move up */
         if (scol < COLNO - 1)
             right_side(nrow, -1, scol, right_row, right, scol, right, limits);
@@ -2713,7 +2882,8 @@ genericptr_t arg;
      * rows here, since we don't do it in the routines right_side() and
      * left_side() [ugliness to remove extra routine calls].
      */
-    if ((nrow = srow + 1) < ROWNO) { /* move down */
+    if ((view_halves & VIEW_DOWN) && (nrow = srow + 1) < ROWNO) {
+        /* move down */
         step = 1;
         if (scol < COLNO - 1)
             right_side(nrow, scol, right, limits);
@@ -2721,7 +2891,8 @@ genericptr_t arg;
             left_side(nrow, left, scol, limits);
     }
 
-    if ((nrow = srow - 1) >= 0) { /* move up */
+    if ((view_halves & VIEW_UP) && (nrow = srow - 1) >= 0) {
+        /* move up */
         step = -1;
         if (scol < COLNO - 1)
             right_side(nrow, scol, right, limits);
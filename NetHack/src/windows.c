@@ -41,6 +41,9 @@ extern struct window_procs Gnome_procs;
 #ifdef MSWIN_GRAPHICS
 extern struct window_procs mswin_procs;
 #endif
+#ifdef HEADLESS_GRAPHICS
+extern struct window_procs headless_procs;
+#endif
 #ifdef WINCHAIN
 extern struct window_procs chainin_procs;
 extern void FDECL(chainin_procs_init, (int));
@@ -120,6 +123,9 @@ static struct win_choices {
 #ifdef MSWIN_GRAPHICS
     { &mswin_procs, 0 CHAINR(0) },
 #endif
+#ifdef HEADLESS_GRAPHICS
+    { &headless_procs, 0 CHAINR(0) },
+#endif
 #ifdef WINCHAIN
     { &chainin_procs, chainin_procs_init, chainin_procs_chain },
     { (struct window_procs *) &chainout_procs, chainout_procs_init,
@@ -4369,7 +4369,7 @@ short exploding_wand_typ;
                         /* leave the no longer existent water */
                         u.uinwater = 0;
                         u.uundetected = 0;
-                        docrt();
+                        refresh_map();
                         vision_full_recalc = 1;
                     } else if (u.utrap && u.utraptype == TT_LAVA) {
                         if (Passes_walls) {
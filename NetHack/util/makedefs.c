@@ -1076,7 +1076,7 @@ rumors_failure:
 /*
  * Use this to explicitly mask out features during version checks.
  *
- * ZEROCOMP, RLECOMP, and ZLIB_COMP describe compression features
+ * ZEROCOMP, RLECOMP, LZCOMP and ZLIB_COMP describe compression features
  * that the port/plaform which wrote the savefile was capable of
  * dealing with. Don't reject a savefile just because the port
  * reading the savefile doesn't match on all/some of them.
@@ -1091,6 +1091,7 @@ rumors_failure:
     (0L | (1L << 19) /* SCORE_ON_BOTL */ \
      | (1L << 27)    /* ZEROCOMP */      \
      | (1L << 28)    /* RLECOMP */       \
+     | (1L << 29)    /* LZCOMP */        \
      )
 
 static void
@@ -1137,6 +1138,9 @@ make_version()
 #endif
 #ifdef RLECOMP
                                            | (1L << 28)
+#endif
+#ifdef LZCOMP
+                                           | (1L << 29)
 #endif
                                                );
     /*
@@ -1632,6 +1636,9 @@ static const char *build_opts[] = {
 #ifdef RLECOMP
     "run-length compression of map in save files",
 #endif
+#ifdef LZCOMP
+    "LZ-compressed save files",
+#endif
 #ifdef SYSCF
     "system configuration at run-time",
 #endif
@@ -220,6 +220,8 @@ char *basename;
     xchar levc;
     struct version_info version_data;
     struct savefile_info sfi;
+    unsigned char toc[6 + MAXCHUNKTOC * CHUNKTOC_ENTSZ];
+    int toclen = 0;
     char plbuf[PL_NSIZ];
 
     /* level 0 file contains:
@@ -227,6 +229,7 @@ char *basename;
      *	level number for current level of save file
      *	name of save file nethack would have created
      *	savefile info
+     *	chunk table of contents, if any
      *	player name
      *	and game state
      */
@@ -268,6 +271,12 @@ char *basename;
         || (read(gfd, (genericptr_t) &version_data, sizeof version_data)
             != sizeof version_data)
         || (read(gfd, (genericptr_t) &sfi, sizeof sfi) != sizeof sfi)
+        || ((sfi.sfi2 & SFI2_CHUNKS) != 0
+            && (read(gfd, (genericptr_t) toc, 6) != 6
+                || (toclen = 6 + (toc[4] | (toc[5] << 8)) * CHUNKTOC_ENTSZ)
+                       > (int) sizeof toc
+                || read(gfd, (genericptr_t) &toc[6], toclen - 6)
+                       != toclen - 6))
         || (read(gfd, (genericptr_t) &pltmpsiz, sizeof pltmpsiz)
             != sizeof pltmpsiz) || (pltmpsiz > PL_NSIZ)
         || (read(gfd, (genericptr_t) &plbuf, pltmpsiz) != pltmpsiz)) {
@@ -279,6 +288,7 @@ char *basename;
     /* save file should contain:
      *	version info
      *	savefile info
+     *	chunk table of contents, if any
      *	player name
      *	current level (including pets)
      *	(non-level-based) game state
@@ -308,6 +318,8 @@ char *basename;
         return -1;
     }
 
+    /* lock files carry no game summary, so neither will the result */
+    sfi.sfi2 &= ~SFI2_SAVEINFO;
     if (write(sfd, (genericptr_t) &sfi, sizeof sfi) != sizeof sfi) {
         Fprintf(stderr,
                 "Error writing %s; recovery failed (savefile_info).\n",
@@ -318,6 +330,16 @@ char *basename;
         return -1;
     }
 
+    if (toclen && write(sfd, (genericptr_t) toc, toclen) != toclen) {
+        Fprintf(stderr,
+                "Error writing %s; recovery failed (table of contents).\n",
+                savename);
+        Close(gfd);
+        Close(sfd);
+        Close(lfd);
+        return -1;
+    }
+
     if (write(sfd, (genericptr_t) &pltmpsiz, sizeof pltmpsiz)
         != sizeof pltmpsiz) {
         Fprintf(stderr,
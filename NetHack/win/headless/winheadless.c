@@ -0,0 +1,540 @@
+/* NetHack 3.6	winheadless.c	$NHDT-Date$  $NHDT-Branch$:$NHDT-Revision$ */
+/* NetHack may be freely redistributed.  See license for details. */
+
+/*
+ * A window port with no display at all, for measuring how fast the
+ * game itself runs.  Nothing is drawn; commands come from a script
+ * file and, once that runs out, from a random stream of moves and
+ * searches.  The random number generator is seeded with a fixed
+ * value, so two runs with the same seed, script and options play
+ * the same game (apart from things that go by the real date, such
+ * as the phase of the moon).  Each turn writes one line to a log:
+ *
+ *      <turn> <cpu usec> <commands> <monsters> <depth>
+ *
+ * Controlled through the environment:
+ *      HEADLESS_SEED      seed for the game's RNG (default 1)
+ *      HEADLESS_SCRIPT    file of keystrokes to play first; getlin()
+ *                         and extended commands take a whole line
+ *      HEADLESS_TURNS     quit once this turn is reached (default 1000)
+ *      HEADLESS_LOG       where the timing log goes (default stdout)
+ * Relative paths are taken from the playground directory.  A set-id
+ * game refuses to start if HEADLESS_SCRIPT or HEADLESS_LOG is set.
+ *
+ * The port is only compiled in with HEADLESS_GRAPHICS; "make benchmark"
+ * in src links it into a separate, unprivileged nethack-bench binary.
+ *
+ * Best run in explore mode (-X) so that the hero declines to die.
+ */
+
+#include "hack.h"
+#include "func_tab.h"
+
+#ifdef HEADLESS_GRAPHICS
+
+static void FDECL(hl_init_nhwindows, (int *, char **));
+static void NDECL(hl_player_selection);
+static void NDECL(hl_askname);
+static void FDECL(hl_exit_nhwindows, (const char *));
+static winid FDECL(hl_create_nhwindow, (int));
+static void FDECL(hl_display_nhwindow, (winid, BOOLEAN_P));
+static void FDECL(hl_curs, (winid, int, int));
+static void FDECL(hl_putstr, (winid, int, const char *));
+static void FDECL(hl_display_file, (const char *, BOOLEAN_P));
+static void FDECL(hl_add_menu, (winid, int, const anything *, CHAR_P, CHAR_P,
+                                int, const char *, BOOLEAN_P));
+static void FDECL(hl_end_menu, (winid, const char *));
+static int FDECL(hl_select_menu, (winid, int, MENU_ITEM_P **));
+#ifdef CLIPPING
+static void FDECL(hl_cliparound, (int, int));
+#endif
+static void FDECL(hl_print_glyph, (winid, XCHAR_P, XCHAR_P, int, int));
+static void FDECL(hl_raw_print, (const char *));
+static int NDECL(hl_nhgetch);
+static int FDECL(hl_nh_poskey, (int *, int *, int *));
+static char FDECL(hl_yn_function, (const char *, const char *, CHAR_P));
+static void FDECL(hl_getlin, (const char *, char *));
+static int NDECL(hl_get_ext_cmd);
+#ifdef CHANGE_COLOR
+static void FDECL(hl_change_color, (int, long, int));
+#ifdef MAC
+static short FDECL(hl_set_font_name, (winid, char *));
+#endif
+static char *NDECL(hl_get_color_string);
+#endif /* CHANGE_COLOR */
+static void FDECL(hl_outrip, (winid, int, time_t));
+static void FDECL(hl_status_update, (int, genericptr_t, int, int, int,
+                                     unsigned long *));
+
+static int NDECL(hl_int_ndecl);
+static void NDECL(hl_void_ndecl);
+static void FDECL(hl_void_fdecl_int, (int));
+static void FDECL(hl_void_fdecl_winid, (winid));
+static void FDECL(hl_void_fdecl_constchar_p, (const char *));
+
+static int NDECL(hl_script_key);
+static int NDECL(hl_random_key);
+static void NDECL(hl_turn_log);
+
+struct window_procs headless_procs = {
+    "headless", 0L, 0L, hl_init_nhwindows, hl_player_selection, hl_askname,
+    hl_void_ndecl,                                     /* get_nh_event */
+    hl_exit_nhwindows, hl_void_fdecl_constchar_p,      /* suspend_nhwindows */
+    hl_void_ndecl,                                     /* resume_nhwindows */
+    hl_create_nhwindow, hl_void_fdecl_winid,           /* clear_nhwindow */
+    hl_display_nhwindow, hl_void_fdecl_winid,          /* destroy_nhwindow */
+    hl_curs, hl_putstr, hl_putstr,                     /* putmixed */
+    hl_display_file, hl_void_fdecl_winid,              /* start_menu */
+    hl_add_menu, hl_end_menu, hl_select_menu, genl_message_menu,
+    hl_void_ndecl,                                     /* update_inventory */
+    hl_void_ndecl,                                     /* mark_synch */
+    hl_void_ndecl,                                     /* wait_synch */
+#ifdef CLIPPING
+    hl_cliparound,
+#endif
+#ifdef POSITIONBAR
+    (void FDECL((*), (char *))) hl_void_fdecl_constchar_p,
+                                                      /* update_positionbar */
+#endif
+    hl_print_glyph, hl_raw_print, hl_raw_print,       /* raw_print_bold */
+    hl_nhgetch, hl_nh_poskey, hl_void_ndecl,          /* nhbell */
+    hl_int_ndecl,                                     /* doprev_message */
+    hl_yn_function, hl_getlin, hl_get_ext_cmd,
+    hl_void_fdecl_int,                                /* number_pad */
+    hl_void_ndecl,                                    /* delay_output */
+#ifdef CHANGE_COLOR
+    hl_change_color,
+#ifdef MAC
+    hl_void_fdecl_int,                                /* change_background */
+    hl_set_font_name,
+#endif
+    hl_get_color_string,
+#endif /* CHANGE_COLOR */
+    hl_void_ndecl,                                    /* start_screen */
+    hl_void_ndecl,                                    /* end_screen */
+    hl_outrip, genl_preference_update, genl_getmsghistory,
+    genl_putmsghistory, genl_status_init, genl_status_finish,
+    genl_status_enablefield, hl_status_update,
+    genl_can_suspend_no,
+};
+
+static char *script = 0;         /* keystrokes still to be played */
+static long scriptlen = 0L, scriptpos = 0L;
+static long maxturns = 1000L;
+static FILE *hl_logf = (FILE *) 0;
+static winid nextwin = 0;
+
+/* per-turn accounting */
+static long lastturn = 0L, ncmds = 0L, nturns = 0L;
+static clock_t turnstart, runstart;
+
+#define CPU_USEC(c) ((long) ((double) (c) * 1000000.0 / CLOCKS_PER_SEC))
+
+/*ARGSUSED*/
+static void
+hl_init_nhwindows(argc_p, argv)
+int *argc_p UNUSED;
+char **argv UNUSED;
+{
+    const char *s;
+    FILE *fp;
+    unsigned long seed = 1L;
+    boolean setid = FALSE;
+
+#ifdef UNIX
+    /* an installed set-id game must not read or write files that
+       the player names */
+    setid = (getuid() != geteuid() || getgid() != getegid());
+#endif
+    if (setid && (nh_getenv("HEADLESS_SCRIPT") || nh_getenv("HEADLESS_LOG"))) {
+        raw_print("headless: HEADLESS_SCRIPT and HEADLESS_LOG are not allowed"
+                  " in a set-id game.");
+        nh_terminate(EXIT_FAILURE);
+    }
+
+    if ((s = nh_getenv("HEADLESS_SEED")) != 0 && *s)
+        seed = strtoul(s, (char **) 0, 0);
+    set_random(seed);
+
+    if ((s = nh_getenv("HEADLESS_TURNS")) != 0 && atol(s) > 0)
+        maxturns = atol(s);
+
+    if ((s = nh_getenv("HEADLESS_SCRIPT")) != 0 && *s) {
+        if ((fp = fopen(s, "r")) == 0) {
+            perror(s);
+            nh_terminate(EXIT_FAILURE);
+        }
+        (void) fseek(fp, 0L, SEEK_END);
+        scriptlen = ftell(fp);
+        (void) fseek(fp, 0L, SEEK_SET);
+        script = (char *) alloc((unsigned) scriptlen + 1);
+        scriptlen = (long) fread(script, 1, (size_t) scriptlen, fp);
+        (void) fclose(fp);
+    }
+
+    hl_logf = stdout;
+    if ((s = nh_getenv("HEADLESS_LOG")) != 0 && *s
+        && (hl_logf = fopen(s, "w")) == 0) {
+        perror(s);
+        nh_terminate(EXIT_FAILURE);
+    }
+    (void) fprintf(hl_logf, "# turn\tcpu_us\tcmds\tmons\tdepth\n");
+
+    runstart = turnstart = clock();
+    iflags.window_inited = 1;
+}
+
+/* anything not given by the options is picked at random */
+static void
+hl_player_selection()
+{
+    if (flags.initrole == ROLE_NONE)
+        flags.initrole = ROLE_RANDOM;
+    if (flags.initrace == ROLE_NONE)
+        flags.initrace = ROLE_RANDOM;
+    if (flags.initgend == ROLE_NONE)
+        flags.initgend = ROLE_RANDOM;
+    if (flags.initalign == ROLE_NONE)
+        flags.initalign = ROLE_RANDOM;
+    rigid_role_checks();
+}
+
+static void
+hl_askname()
+{
+    if (!*plname)
+        Strcpy(plname, "headless");
+}
+
+static void
+hl_exit_nhwindows(str)
+const char *str;
+{
+    long usec = CPU_USEC(clock() - runstart);
+
+    if (hl_logf) {
+        (void) fprintf(hl_logf,
+                   "# %ld turns, %ld commands, %ld.%03ld s cpu, %ld turns/s\n",
+                       nturns, ncmds, usec / 1000000L, (usec / 1000L) % 1000L,
+                       usec ? (long) ((double) nturns * 1000000.0 / usec)
+                            : 0L);
+        if (hl_logf != stdout)
+            (void) fclose(hl_logf);
+        else
+            (void) fflush(hl_logf);
+        hl_logf = (FILE *) 0;
+    }
+    if (script)
+        free((genericptr_t) script), script = 0;
+    if (str && *str)
+        hl_raw_print(str);
+    iflags.window_inited = 0;
+}
+
+/*ARGSUSED*/
+static winid
+hl_create_nhwindow(type)
+int type UNUSED;
+{
+    return nextwin++;
+}
+
+/*ARGSUSED*/
+static void
+hl_display_nhwindow(window, blocking)
+winid window UNUSED;
+boolean blocking UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_curs(window, x, y)
+winid window UNUSED;
+int x UNUSED, y UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_putstr(window, attr, text)
+winid window UNUSED;
+int attr UNUSED;
+const char *text UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_display_file(fname, complain)
+const char *fname UNUSED;
+boolean complain UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_add_menu(window, glyph, identifier, sel, grpsel, attr, txt, preselected)
+winid window UNUSED;
+int glyph UNUSED, attr UNUSED;
+const anything *identifier UNUSED;
+char sel UNUSED, grpsel UNUSED;
+const char *txt UNUSED;
+boolean preselected UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_end_menu(window, prompt)
+winid window UNUSED;
+const char *prompt UNUSED;
+{
+    return;
+}
+
+/* nothing is ever picked from a menu */
+/*ARGSUSED*/
+static int
+hl_select_menu(window, how, menu_list)
+winid window UNUSED;
+int how UNUSED;
+MENU_ITEM_P **menu_list;
+{
+    *menu_list = (MENU_ITEM_P *) 0;
+    return 0;
+}
+
+#ifdef CLIPPING
+/*ARGSUSED*/
+static void
+hl_cliparound(x, y)
+int x UNUSED, y UNUSED;
+{
+    return;
+}
+#endif
+
+/*ARGSUSED*/
+static void
+hl_print_glyph(window, x, y, glyph, bkglyph)
+winid window UNUSED;
+xchar x UNUSED, y UNUSED;
+int glyph UNUSED, bkglyph UNUSED;
+{
+    return;
+}
+
+static void
+hl_raw_print(str)
+const char *str;
+{
+    if (str && *str)
+        (void) fprintf(stderr, "%s\n", str);
+}
+
+/* log the turn that just ended, if one did, and stop at the limit */
+static void
+hl_turn_log()
+{
+    clock_t now;
+    struct monst *mtmp;
+    int nmon = 0;
+
+    if (moves == lastturn)
+        return;
+    now = clock();
+    if (lastturn) {
+        for (mtmp = fmon; mtmp; mtmp = mtmp->nmon)
+            if (!DEADMONSTER(mtmp))
+                nmon++;
+        (void) fprintf(hl_logf, "%ld\t%ld\t%ld\t%d\t%d\n", lastturn,
+                       CPU_USEC(now - turnstart), ncmds, nmon, depth(&u.uz));
+        nturns += moves - lastturn;
+    }
+    lastturn = moves;
+    turnstart = now;
+
+    if (moves >= maxturns) {
+        killer.format = NO_KILLER_PREFIX;
+        Strcpy(killer.name, "ran out of turns");
+        done(QUIT);
+    }
+}
+
+/* next keystroke from the script, or 0 once it is used up */
+static int
+hl_script_key()
+{
+    if (scriptpos >= scriptlen)
+        return 0;
+    return (uchar) script[scriptpos++];
+}
+
+/* mostly walking about, with some searching to let time pass when
+   the hero is boxed in */
+static int
+hl_random_key()
+{
+    static const char keys[] = "hjklyubnhjklyubns";
+
+    return keys[rn2((int) sizeof keys - 1)];
+}
+
+static int
+hl_nhgetch()
+{
+    int c;
+
+    if (program_state.gameover)
+        return '\033';
+    hl_turn_log();
+    ncmds++;
+    if ((c = hl_script_key()) == 0)
+        c = hl_random_key();
+    return c;
+}
+
+static int
+hl_nh_poskey(x, y, mod)
+int *x, *y, *mod;
+{
+    *x = *y = *mod = 0;
+    return hl_nhgetch();
+}
+
+/* a scripted answer if it is one of the choices, otherwise the default */
+static char
+hl_yn_function(prompt, resp, deflt)
+const char *prompt UNUSED, *resp;
+char deflt;
+{
+    int c = hl_script_key();
+
+    if (c && (!resp || index(resp, c)))
+        return (char) c;
+    return deflt ? deflt : '\033';
+}
+
+/* the rest of the current script line */
+/*ARGSUSED*/
+static void
+hl_getlin(prompt, outbuf)
+const char *prompt UNUSED;
+char *outbuf;
+{
+    int c, n = 0;
+
+    while ((c = hl_script_key()) != 0 && c != '\n')
+        if (n < BUFSZ - 1)
+            outbuf[n++] = (char) c;
+    outbuf[n] = '\0';
+    if (!n && !c)
+        Strcpy(outbuf, "\033");
+}
+
+static int
+hl_get_ext_cmd()
+{
+    char buf[BUFSZ];
+    int i;
+
+    hl_getlin("#", buf);
+    for (i = 0; extcmdlist[i].ef_txt; i++)
+        if (!strcmpi(buf, extcmdlist[i].ef_txt))
+            return i;
+    return -1;
+}
+
+#ifdef CHANGE_COLOR
+/*ARGSUSED*/
+static void
+hl_change_color(color, rgb, reverse)
+int color UNUSED, reverse UNUSED;
+long rgb UNUSED;
+{
+    return;
+}
+
+#ifdef MAC
+/*ARGSUSED*/
+static short
+hl_set_font_name(window, fontname)
+winid window UNUSED;
+char *fontname UNUSED;
+{
+    return 0;
+}
+#endif
+
+static char *
+hl_get_color_string(VOID_ARGS)
+{
+    return (char *) 0;
+}
+#endif /* CHANGE_COLOR */
+
+/*ARGSUSED*/
+static void
+hl_outrip(tmpwin, how, when)
+winid tmpwin UNUSED;
+int how UNUSED;
+time_t when UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_status_update(idx, ptr, chg, percent, color, colormasks)
+int idx UNUSED, chg UNUSED, percent UNUSED, color UNUSED;
+genericptr_t ptr UNUSED;
+unsigned long *colormasks UNUSED;
+{
+    return;
+}
+
+static int
+hl_int_ndecl(VOID_ARGS)
+{
+    return 0;
+}
+
+static void
+hl_void_ndecl(VOID_ARGS)
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_void_fdecl_int(arg)
+int arg UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_void_fdecl_winid(window)
+winid window UNUSED;
+{
+    return;
+}
+
+/*ARGSUSED*/
+static void
+hl_void_fdecl_constchar_p(string)
+const char *string UNUSED;
+{
+    return;
+}
+
+#endif /* HEADLESS_GRAPHICS */
+
+/*winheadless.c*/
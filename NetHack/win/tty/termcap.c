@@ -565,6 +565,47 @@ int x, y;
     }
 }
 
+/* number of bytes nocmov() would send to get from <fx,fy> to <x,y>;
+   MOTION_NONE if it would have to fall back on something else */
+int
+nocmov_cost(fx, fy, x, y)
+int fx, fy, x, y;
+{
+    int cost = 0;
+
+    if (fy > y) {
+        if (!UP)
+            return MOTION_NONE;
+        cost += (fy - y) * (int) strlen(UP);
+    } else if (fy < y) {
+        if (XD) {
+            cost += (y - fy) * (int) strlen(XD);
+        } else if (!nh_CM) {
+            cost += y - fy; /* newlines, which also take us to column 0 */
+            fx = 0;
+        } else
+            return MOTION_NONE;
+    }
+    if (fx < x) {
+        if (!nh_ND)
+            return MOTION_NONE;
+        cost += (x - fx) * (int) strlen(nh_ND);
+    } else if (fx > x) {
+        cost += (fx - x) * (int) strlen(BC);
+    }
+    return cost;
+}
+
+/* number of bytes cmov() would send to get to <x,y> */
+int
+cmov_cost(x, y)
+int x, y;
+{
+    if (!nh_CM)
+        return MOTION_NONE;
+    return (int) strlen(tgoto(nh_CM, x, y));
+}
+
 void
 cmov(x, y)
 register int x, y;
@@ -583,7 +624,7 @@ xputc(c)
     char c;
 #endif
 {
-    (void) putchar(c);
+    tty_putchar(c);
 }
 
 void
@@ -591,6 +632,7 @@ xputs(s)
 const char *s;
 {
 #ifndef TERMLIB
+    tty_obytes += (long) strlen(s);
     (void) fputs(s, stdout);
 #else
 #if defined(NHSTDC) || defined(ULTRIX_PROTO)
@@ -707,8 +749,8 @@ tty_nhbell()
 {
     if (flags.silent)
         return;
-    (void) putchar('\007'); /* curx does not change */
-    (void) fflush(stdout);
+    tty_putchar('\007'); /* curx does not change */
+    tty_flush();
 }
 
 #ifdef ASCIIGRAPH
@@ -750,7 +792,7 @@ tty_delay_output()
 #endif
 #ifdef TIMED_DELAY
     if (flags.nap) {
-        (void) fflush(stdout);
+        tty_flush();
         msleep(50); /* sleep for 50 milliseconds */
         return;
     }
@@ -759,7 +801,7 @@ tty_delay_output()
     /* simulate the delay with "cursor here" */
     for (i = 0; i < 3; i++) {
         cmov(ttyDisplay->curx, ttyDisplay->cury);
-        (void) fflush(stdout);
+        tty_flush();
     }
 #else /* MICRO */
     /* BUG: if the padding character is visible, as it is on the 5620
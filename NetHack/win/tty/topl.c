@@ -14,12 +14,280 @@
 #define C(c) (0x1f & (c))
 #endif
 
+/*
+ * Message history is kept in one ring.  The text of the remembered
+ * messages is stored back to back in text[], and ent[] indexes it with
+ * the oldest entry at first.  A message which won't fit at the end of
+ * text[] starts over at the beginning, forgetting the oldest messages
+ * in its way.  A message repeating the most recent one just bumps that
+ * one's count, shown as "(xN)" when it is recalled.
+ */
+struct msgent {
+    unsigned off;   /* where the message starts in text[] */
+    unsigned count; /* how many times in a row it was issued */
+};
+
+struct msgring {
+    char *text;          /* NUL terminated messages */
+    struct msgent *ent;  /* circular array of max entries */
+    unsigned size, next; /* size of text[]; where the next message goes */
+    int max, first, cnt; /* capacity; oldest entry; entries in use */
+};
+
+#define MSGAVGLEN 96 /* text[] bytes per message allowed for */
+/* age 0 is the most recent message */
+#define msgring_ent(r, age) \
+    (&(r)->ent[((r)->first + (r)->cnt - 1 - (age)) % (r)->max])
+#define msgring_drop(r) \
+    ((r)->first = ((r)->first + 1) % (r)->max, (r)->cnt--)
+
 STATIC_DCL void FDECL(redotoplin, (const char *));
 STATIC_DCL void FDECL(topl_putsym, (CHAR_P));
+STATIC_DCL int FDECL(topl_putmbsym, (const char *));
 STATIC_DCL void NDECL(remember_topl);
 STATIC_DCL void FDECL(removetopl, (int));
 STATIC_DCL void FDECL(msghistory_snapshot, (BOOLEAN_P));
 STATIC_DCL void FDECL(free_msghistory_snapshot, (BOOLEAN_P));
+STATIC_DCL void FDECL(msgring_alloc, (struct msgring *, int));
+STATIC_DCL void FDECL(msgring_free, (struct msgring *));
+STATIC_DCL void FDECL(msgring_add, (struct msgring *, const char *,
+                                    unsigned));
+STATIC_DCL boolean NDECL(topl_repeats);
+STATIC_DCL int NDECL(recall_count);
+STATIC_DCL const char *FDECL(recall_msg, (int, unsigned *));
+STATIC_DCL const char *FDECL(recall_line, (int));
+STATIC_DCL int FDECL(search_msgs, (const char *, int));
+STATIC_DCL void NDECL(msghistory_search);
+STATIC_DCL unsigned FDECL(msg_repeat_count, (char *));
+
+extern char erase_char; /* from xxxtty.c; don't need kill_char */
+
+static struct msgring msgs, snapmsgs;
+/* the message window's data[] is unused; its maxcol is how far back ^P
+   has gone (0 is toplines[]) and maxrow stays 0, so that the long
+   standing "cw->maxcol = cw->maxrow" still resets recall */
+
+STATIC_OVL void
+msgring_alloc(r, max)
+struct msgring *r;
+int max;
+{
+    r->max = max;
+    r->size = (unsigned) max * MSGAVGLEN;
+    if (r->size < 4 * TBUFSZ)
+        r->size = 4 * TBUFSZ;
+    r->text = (char *) alloc(r->size);
+    r->ent = (struct msgent *) alloc((unsigned) max * sizeof (struct msgent));
+    r->next = 0;
+    r->first = r->cnt = 0;
+}
+
+STATIC_OVL void
+msgring_free(r)
+struct msgring *r;
+{
+    if (r->text)
+        free((genericptr_t) r->text), r->text = (char *) 0;
+    if (r->ent)
+        free((genericptr_t) r->ent), r->ent = (struct msgent *) 0;
+    r->size = r->next = 0;
+    r->max = r->first = r->cnt = 0;
+}
+
+STATIC_OVL void
+msgring_add(r, msg, count)
+struct msgring *r;
+const char *msg;
+unsigned count;
+{
+    struct msgent *e;
+    unsigned len = (unsigned) strlen(msg) + 1;
+
+    if (!r->max || !*msg)
+        return;
+    if (r->cnt && !strcmp(r->text + msgring_ent(r, 0)->off, msg)) {
+        msgring_ent(r, 0)->count += count;
+        return;
+    }
+    if (len > TBUFSZ)
+        len = TBUFSZ; /* shouldn't happen */
+
+    if (r->next + len > r->size) {
+        /* whatever is left past here is the oldest text; wrap around */
+        while (r->cnt && r->ent[r->first].off >= r->next)
+            msgring_drop(r);
+        r->next = 0;
+    }
+    /* entries from the previous lap all start at or beyond next */
+    while (r->cnt && (r->cnt == r->max
+                      || (r->ent[r->first].off >= r->next
+                          && r->ent[r->first].off < r->next + len)))
+        msgring_drop(r);
+
+    e = &r->ent[(r->first + r->cnt++) % r->max];
+    e->off = r->next;
+    e->count = count;
+    (void) memcpy((genericptr_t) (r->text + r->next), (genericptr_t) msg,
+                  len - 1);
+    r->text[r->next + len - 1] = '\0';
+    r->next += len;
+}
+
+/* allocate the message history; called when the message window is made */
+void
+init_msghistory(max)
+int max;
+{
+    if (!msgs.max)
+        msgring_alloc(&msgs, max);
+}
+
+void
+free_msghistory()
+{
+    msgring_free(&msgs);
+    msgring_free(&snapmsgs);
+}
+
+/* is toplines[] the same as the most recently remembered message? */
+STATIC_OVL boolean
+topl_repeats()
+{
+    return (boolean) (*toplines && msgs.cnt
+                      && !strcmp(toplines,
+                                 msgs.text + msgring_ent(&msgs, 0)->off));
+}
+
+/* number of messages ^P can show */
+STATIC_OVL int
+recall_count()
+{
+    return msgs.cnt + (*toplines ? 1 : 0) - (topl_repeats() ? 1 : 0);
+}
+
+/* message back steps before the current one, and its repeat count;
+   a toplines[] repeating the newest remembered message is merged in */
+STATIC_OVL const char *
+recall_msg(back, countp)
+int back;
+unsigned *countp;
+{
+    struct msgent *e;
+
+    if (*toplines) {
+        if (topl_repeats()) {
+            if (!back) {
+                *countp = msgring_ent(&msgs, 0)->count + 1;
+                return toplines;
+            }
+        } else if (!back) {
+            *countp = 1;
+            return toplines;
+        } else
+            back--;
+    }
+    if (back < 0 || back >= msgs.cnt)
+        return (const char *) 0;
+    e = msgring_ent(&msgs, back);
+    *countp = e->count;
+    return msgs.text + e->off;
+}
+
+/* recall_msg() formatted for display */
+STATIC_OVL const char *
+recall_line(back)
+int back;
+{
+    static char linebuf[TBUFSZ + 20];
+    unsigned count;
+    const char *msg = recall_msg(back, &count);
+
+    if (!msg)
+        return "";
+    if (count < 2)
+        return msg;
+    Sprintf(linebuf, "%.*s (x%u)", TBUFSZ - 1, msg, count);
+    return linebuf;
+}
+
+/* find the first message at or beyond back which contains pat */
+STATIC_OVL int
+search_msgs(pat, back)
+const char *pat;
+int back;
+{
+    const char *msg;
+    unsigned count;
+
+    for (; (msg = recall_msg(back, &count)) != 0; back++)
+        if (strstri(msg, pat))
+            return back;
+    return -1;
+}
+
+/* incremental search of message history, for m^P; each character typed
+   narrows the search, ^P finds the next older match, and backspace
+   widens it again */
+STATIC_OVL void
+msghistory_search()
+{
+    struct WinDesc *cw = wins[WIN_MESSAGE];
+    char pat[BUFSZ], buf[BUFSZ + TBUFSZ + 20], *p;
+    int c, plen = 0, found = -1;
+
+    pat[0] = '\0';
+    tty_clear_nhwindow(WIN_MESSAGE);
+    for (;;) {
+        if (!plen)
+            Strcpy(buf, "消息搜索: ");
+        else if (found >= 0)
+            Sprintf(buf, "消息搜索 '%s': %s", pat, recall_line(found));
+        else
+            Sprintf(buf, "消息搜索 '%s': (无匹配)", pat);
+        for (p = buf; *p; p++)
+            if (*p == '\n')
+                *p = ' ';
+        buf[tty_strfit(buf, CO - 1)] = '\0';
+        home();
+        putsyms(buf);
+        cl_end();
+        ttyDisplay->toplin = 3;
+
+        c = tty_nhgetch();
+        if (c == '\033' || c == '\n' || c == '\r')
+            break;
+        if (c == C('p')) {
+            if (found < 0 || (c = search_msgs(pat, found + 1)) < 0)
+                tty_nhbell();
+            else
+                found = c;
+        } else if (c == erase_char || c == '\b' || c == '\177') {
+            if (!plen) {
+                tty_nhbell();
+                continue;
+            }
+            /* drop a whole character, not just its last byte */
+            while (--plen > 0 && (pat[plen] & 0xc0) == 0x80)
+                continue;
+            pat[plen] = '\0';
+            found = plen ? search_msgs(pat, 0) : -1;
+        } else if (plen < BUFSZ - 1 && (c >= ' ' || (c & 0x80))) {
+            pat[plen++] = (char) c;
+            pat[plen] = '\0';
+            found = search_msgs(pat, (found < 0) ? 0 : found);
+        } else
+            tty_nhbell();
+    }
+    home();
+    cl_end();
+    cw->curx = cw->cury = 0;
+    ttyDisplay->toplin = 0;
+    /* leave the match showing; plain ^P carries on from there */
+    if (c != '\033' && found >= 0) {
+        redotoplin(recall_line(found));
+        cw->maxcol = (found + 1) % recall_count();
+    }
+}
 
 int
 tty_doprev_message()
@@ -27,54 +295,39 @@ tty_doprev_message()
     register struct WinDesc *cw = wins[WIN_MESSAGE];
 
     winid prevmsg_win;
-    int i;
-    if ((iflags.prevmsg_window != 's')
+    int i, n = recall_count();
+
+    if (!n)
+        return 0;
+    if (cw->maxcol >= n)
+        cw->maxcol = 0;
+    if (iflags.menu_requested && !ttyDisplay->inread) {
+        msghistory_search();
+    } else if ((iflags.prevmsg_window != 's')
         && !ttyDisplay->inread) {           /* not single */
         if (iflags.prevmsg_window == 'f') { /* full */
             prevmsg_win = create_nhwindow(NHW_MENU);
             putstr(prevmsg_win, 0, "Message History");
             putstr(prevmsg_win, 0, "");
-            cw->maxcol = cw->maxrow;
-            i = cw->maxcol;
-            do {
-                if (cw->data[i] && strcmp(cw->data[i], ""))
-                    putstr(prevmsg_win, 0, cw->data[i]);
-                i = (i + 1) % cw->rows;
-            } while (i != cw->maxcol);
-            putstr(prevmsg_win, 0, toplines);
+            cw->maxcol = 0;
+            for (i = n - 1; i >= 0; i--)
+                putstr(prevmsg_win, 0, recall_line(i));
             display_nhwindow(prevmsg_win, TRUE);
             destroy_nhwindow(prevmsg_win);
         } else if (iflags.prevmsg_window == 'c') { /* combination */
             do {
                 morc = 0;
-                if (cw->maxcol == cw->maxrow) {
-                    ttyDisplay->dismiss_more = C('p'); /* ^P ok at --More-- */
-                    redotoplin(toplines);
-                    cw->maxcol--;
-                    if (cw->maxcol < 0)
-                        cw->maxcol = cw->rows - 1;
-                    if (!cw->data[cw->maxcol])
-                        cw->maxcol = cw->maxrow;
-                } else if (cw->maxcol == (cw->maxrow - 1)) {
+                if (cw->maxcol < 2) {
                     ttyDisplay->dismiss_more = C('p'); /* ^P ok at --More-- */
-                    redotoplin(cw->data[cw->maxcol]);
-                    cw->maxcol--;
-                    if (cw->maxcol < 0)
-                        cw->maxcol = cw->rows - 1;
-                    if (!cw->data[cw->maxcol])
-                        cw->maxcol = cw->maxrow;
+                    redotoplin(recall_line((int) cw->maxcol));
+                    cw->maxcol = (cw->maxcol + 1) % n;
                 } else {
                     prevmsg_win = create_nhwindow(NHW_MENU);
                     putstr(prevmsg_win, 0, "Message History");
                     putstr(prevmsg_win, 0, "");
-                    cw->maxcol = cw->maxrow;
-                    i = cw->maxcol;
-                    do {
-                        if (cw->data[i] && strcmp(cw->data[i], ""))
-                            putstr(prevmsg_win, 0, cw->data[i]);
-                        i = (i + 1) % cw->rows;
-                    } while (i != cw->maxcol);
-                    putstr(prevmsg_win, 0, toplines);
+                    cw->maxcol = 0;
+                    for (i = n - 1; i >= 0; i--)
+                        putstr(prevmsg_win, 0, recall_line(i));
                     display_nhwindow(prevmsg_win, TRUE);
                     destroy_nhwindow(prevmsg_win);
                 }
@@ -86,37 +339,20 @@ tty_doprev_message()
             prevmsg_win = create_nhwindow(NHW_MENU);
             putstr(prevmsg_win, 0, "Message History");
             putstr(prevmsg_win, 0, "");
-            putstr(prevmsg_win, 0, toplines);
-            cw->maxcol = cw->maxrow - 1;
-            if (cw->maxcol < 0)
-                cw->maxcol = cw->rows - 1;
-            do {
-                putstr(prevmsg_win, 0, cw->data[cw->maxcol]);
-                cw->maxcol--;
-                if (cw->maxcol < 0)
-                    cw->maxcol = cw->rows - 1;
-                if (!cw->data[cw->maxcol])
-                    cw->maxcol = cw->maxrow;
-            } while (cw->maxcol != cw->maxrow);
+            for (i = 0; i < n; i++)
+                putstr(prevmsg_win, 0, recall_line(i));
 
             display_nhwindow(prevmsg_win, TRUE);
             destroy_nhwindow(prevmsg_win);
-            cw->maxcol = cw->maxrow;
+            cw->maxcol = 0;
             ttyDisplay->dismiss_more = 0;
         }
     } else if (iflags.prevmsg_window == 's') { /* single */
         ttyDisplay->dismiss_more = C('p'); /* <ctrl/P> allowed at --More-- */
         do {
             morc = 0;
-            if (cw->maxcol == cw->maxrow)
-                redotoplin(toplines);
-            else if (cw->data[cw->maxcol])
-                redotoplin(cw->data[cw->maxcol]);
-            cw->maxcol--;
-            if (cw->maxcol < 0)
-                cw->maxcol = cw->rows - 1;
-            if (!cw->data[cw->maxcol])
-                cw->maxcol = cw->maxrow;
+            redotoplin(recall_line((int) cw->maxcol));
+            cw->maxcol = (cw->maxcol + 1) % n;
         } while (morc == C('p'));
         ttyDisplay->dismiss_more = 0;
     }
@@ -148,22 +384,13 @@ STATIC_OVL void
 remember_topl()
 {
     register struct WinDesc *cw = wins[WIN_MESSAGE];
-    int idx = cw->maxrow;
-    unsigned len = strlen(toplines) + 1;
 
     if ((cw->flags & WIN_LOCKHISTORY) || !*toplines)
         return;
 
-    if (len > (unsigned) cw->datlen[idx]) {
-        if (cw->data[idx])
-            free(cw->data[idx]);
-        len += (8 - (len & 7)); /* pad up to next multiple of 8 */
-        cw->data[idx] = (char *) alloc(len);
-        cw->datlen[idx] = (short) len;
-    }
-    Strcpy(cw->data[idx], toplines);
+    msgring_add(&msgs, toplines, 1U);
     *toplines = '\0';
-    cw->maxcol = cw->maxrow = (idx + 1) % cw->rows;
+    cw->maxcol = cw->maxrow;
 }
 
 void
@@ -228,9 +455,9 @@ register const char *bp;
 
     /* If there is room on the line, print message on same line */
     /* But messages like "You die..." deserve their own line */
-    n0 = strlen(bp);
+    n0 = tty_strwidth(bp);
     if ((ttyDisplay->toplin == 1 || (cw->flags & WIN_STOP)) && cw->cury == 0
-        && n0 + (int) strlen(toplines) + 3 < CO - 8 /* room for --More-- */
+        && n0 + tty_strwidth(toplines) + 3 < CO - 8 /* room for --More-- */
         && (notdied = strncmp(bp, "You die", 7)) != 0) {
         Strcat(toplines, "  ");
         Strcat(toplines, bp);
@@ -250,19 +477,20 @@ register const char *bp;
     (void) strncpy(toplines, bp, TBUFSZ);
     toplines[TBUFSZ - 1] = 0;
 
+    /* n0 and CO are screen columns; tl steps through bytes */
     for (tl = toplines; n0 >= CO; ) {
         otl = tl;
-        for (tl += CO - 1; tl != otl; --tl)
+        for (tl += tty_strfit(otl, CO - 1); tl != otl; --tl)
             if (*tl == ' ')
                 break;
         if (tl == otl) {
             /* Eek!  A huge token.  Try splitting after it. */
             tl = index(otl, ' ');
             if (!tl)
-                break; /* No choice but to spit it out whole. */
+                break; /* No choice but to let putsyms() wrap it. */
         }
         *tl++ = '\n';
-        n0 = strlen(tl);
+        n0 = tty_strwidth(tl);
     }
     if (!notdied)
         cw->flags &= ~WIN_STOP;
@@ -294,14 +522,14 @@ char c;
         ttyDisplay->cury++;
         cw->cury = ttyDisplay->cury;
 #ifdef WIN32CON
-        (void) putchar(c);
+        tty_putchar(c);
 #endif
         break;
     default:
         if (ttyDisplay->curx == CO - 1)
             topl_putsym('\n'); /* 1 <= curx < CO; avoid CO */
 #ifdef WIN32CON
-        (void) putchar(c);
+        tty_putchar(c);
 #endif
         ttyDisplay->curx++;
     }
@@ -309,16 +537,39 @@ char c;
     if (cw->curx == 0)
         cl_end();
 #ifndef WIN32CON
-    (void) putchar(c);
+    tty_putchar(c);
 #endif
 }
 
+/* put a possibly multibyte character on the message line, wrapping
+   before it rather than splitting it; returns its length in bytes */
+STATIC_OVL int
+topl_putmbsym(s)
+const char *s;
+{
+    register struct WinDesc *cw = wins[WIN_MESSAGE];
+    int i, n = tty_charlen(s), w;
+
+    if (n == 1) {
+        topl_putsym(*s);
+        return 1;
+    }
+    w = tty_charwidth(s);
+    if (ttyDisplay->curx + w > CO - 1)
+        topl_putsym('\n');
+    for (i = 0; i < n; i++)
+        tty_putchar(s[i]);
+    ttyDisplay->curx += w;
+    cw->curx = ttyDisplay->curx;
+    return n;
+}
+
 void
 putsyms(str)
 const char *str;
 {
     while (*str)
-        topl_putsym(*str++);
+        str += topl_putmbsym(str);
 }
 
 STATIC_OVL void
@@ -330,8 +581,6 @@ register int n;
         putsyms("\b \b");
 }
 
-extern char erase_char; /* from xxxtty.c; don't need kill_char */
-
 /* returns a single keystroke; also sets 'yn_number' */
 char
 tty_yn_function(query, resp, def)
@@ -516,17 +765,12 @@ char def;
     return q;
 }
 
-/* shared by tty_getmsghistory() and tty_putmsghistory() */
-static char **snapshot_mesgs = 0;
-
-/* collect currently available message history data into a sequential array;
-   optionally, purge that data from the active circular buffer set as we go */
+/* collect currently available message history; optionally, move it
+   aside so that the active history is left empty */
 STATIC_OVL void
 msghistory_snapshot(purge)
-boolean purge; /* clear message history buffer as we copy it */
+boolean purge; /* take the history away rather than just locking it */
 {
-    char *mesg;
-    int i, inidx, outidx;
     struct WinDesc *cw;
 
     /* paranoia (too early or too late panic save attempt?) */
@@ -537,55 +781,29 @@ boolean purge; /* clear message history buffer as we copy it */
     /* flush toplines[], moving most recent message to history */
     remember_topl();
 
-    /* for a passive snapshot, we just copy pointers, so can't allow further
-       history updating to take place because that could clobber them */
-    if (!purge)
+    if (purge) {
+        /* the whole ring is two allocations; hand them over */
+        msgring_free(&snapmsgs);
+        snapmsgs = msgs;
+        msgring_alloc(&msgs, snapmsgs.max ? snapmsgs.max
+                                          : (int) iflags.msg_history);
+        cw->maxcol = cw->maxrow;
+    } else {
+        /* the core reads the ring in place, so it mustn't change */
         cw->flags |= WIN_LOCKHISTORY;
-
-    snapshot_mesgs = (char **) alloc((cw->rows + 1) * sizeof(char *));
-    outidx = 0;
-    inidx = cw->maxrow;
-    for (i = 0; i < cw->rows; ++i) {
-        snapshot_mesgs[i] = (char *) 0;
-        mesg = cw->data[inidx];
-        if (mesg && *mesg) {
-            snapshot_mesgs[outidx++] = mesg;
-            if (purge) {
-                /* we're taking this pointer away; subsequest history
-                   updates will eventually allocate a new one to replace it */
-                cw->data[inidx] = (char *) 0;
-                cw->datlen[inidx] = 0;
-            }
-        }
-        inidx = (inidx + 1) % cw->rows;
     }
-    snapshot_mesgs[cw->rows] = (char *) 0; /* sentinel */
-
-    /* for a destructive snapshot, history is now completely empty */
-    if (purge)
-        cw->maxcol = cw->maxrow = 0;
 }
 
-/* release memory allocated to message history snapshot */
+/* release message history snapshot */
 STATIC_OVL void
 free_msghistory_snapshot(purged)
-boolean purged; /* True: took history's pointers, False: just cloned them */
+boolean purged; /* True: took history away, False: just locked it */
 {
-    if (snapshot_mesgs) {
-        /* snapshot pointers are no longer in use */
-        if (purged) {
-            int i;
-
-            for (i = 0; snapshot_mesgs[i]; ++i)
-                free((genericptr_t) snapshot_mesgs[i]);
-        }
-
-        free((genericptr_t) snapshot_mesgs), snapshot_mesgs = (char **) 0;
-
+    if (purged)
+        msgring_free(&snapmsgs);
+    else if (WIN_MESSAGE != WIN_ERR && wins[WIN_MESSAGE])
         /* history can resume being updated at will now... */
-        if (!purged)
-            wins[WIN_MESSAGE]->flags &= ~WIN_LOCKHISTORY;
-    }
+        wins[WIN_MESSAGE]->flags &= ~WIN_LOCKHISTORY;
 }
 
 /*
@@ -602,24 +820,46 @@ char *
 tty_getmsghistory(init)
 boolean init;
 {
-    static int nxtidx;
-    char *nextmesg;
-    char *result = 0;
+    static int nxtage;
+    static char mesgbuf[TBUFSZ + 20];
+    struct msgent *e;
 
     if (init) {
         msghistory_snapshot(FALSE);
-        nxtidx = 0;
+        nxtage = msgs.cnt - 1;
     }
 
-    if (snapshot_mesgs) {
-        nextmesg = snapshot_mesgs[nxtidx++];
-        if (nextmesg) {
-            result = (char *) nextmesg;
-        } else {
-            free_msghistory_snapshot(FALSE);
-        }
+    if (nxtage < 0 || nxtage >= msgs.cnt) {
+        free_msghistory_snapshot(FALSE);
+        return (char *) 0;
     }
-    return result;
+    e = msgring_ent(&msgs, nxtage);
+    nxtage--;
+    if (e->count < 2)
+        return msgs.text + e->off; /* no need to copy it */
+    Sprintf(mesgbuf, "%.*s (x%u)", TBUFSZ - 1, msgs.text + e->off, e->count);
+    return mesgbuf;
+}
+
+/* split a trailing " (xN)" repeat count off a restored message */
+STATIC_OVL unsigned
+msg_repeat_count(buf)
+char *buf;
+{
+    char *p = eos(buf);
+    unsigned count = 0, scale = 1;
+
+    if (p - buf < 6 || *--p != ')')
+        return 1;
+    while (--p > buf && digit(*p)) {
+        count += (unsigned) (*p - '0') * scale;
+        scale *= 10;
+    }
+    if (p - buf < 3 || count < 2 || *p != 'x' || p[-1] != '('
+        || p[-2] != ' ')
+        return 1;
+    p[-2] = '\0';
+    return count;
 }
 
 /*
@@ -645,7 +885,9 @@ const char *msg;
 boolean restoring_msghist;
 {
     static boolean initd = FALSE;
-    int idx;
+    char buf[TBUFSZ];
+    unsigned count;
+    struct msgent *e;
 #ifdef DUMPLOG
     extern unsigned saved_pline_index; /* pline.c */
 #endif
@@ -664,21 +906,30 @@ boolean restoring_msghist;
 #endif
     }
 
-    if (msg) {
+    if (msg && restoring_msghist) {
+        /* straight into history, keeping its repeat count */
+        copynchars(buf, msg, TBUFSZ - 1);
+        count = msg_repeat_count(buf);
+        msgring_add(&msgs, buf, count);
+#ifdef DUMPLOG
+        dumplogmsg(msg);
+#endif
+    } else if (msg) {
         /* move most recent message to history, make this become most recent */
         remember_topl();
         Strcpy(toplines, msg);
 #ifdef DUMPLOG
         dumplogmsg(toplines);
 #endif
-    } else if (snapshot_mesgs) {
+    } else if (initd) {
         /* done putting arbitrary messages in; put the snapshot ones back */
-        for (idx = 0; snapshot_mesgs[idx]; ++idx) {
-            remember_topl();
-            Strcpy(toplines, snapshot_mesgs[idx]);
+        while (snapmsgs.cnt > 0) {
+            e = msgring_ent(&snapmsgs, snapmsgs.cnt - 1);
+            msgring_add(&msgs, snapmsgs.text + e->off, e->count);
 #ifdef DUMPLOG
-            dumplogmsg(toplines);
+            dumplogmsg(snapmsgs.text + e->off);
 #endif
+            msgring_drop(&snapmsgs);
         }
         /* now release the snapshot */
         free_msghistory_snapshot(TRUE);
@@ -119,9 +119,17 @@ struct DisplayDesc *ttyDisplay; /* the tty display descriptor */
 extern void FDECL(cmov, (int, int));   /* from termcap.c */
 extern void FDECL(nocmov, (int, int)); /* from termcap.c */
 #if defined(UNIX) || defined(VMS)
-static char obuf[BUFSIZ]; /* BUFSIZ is defined in stdio.h */
+/* large enough that a full redraw normally goes out in a single write */
+#define OBUFSIZ (16 * 1024)
+static char obuf[OBUFSIZ];
 #endif
 
+/* terminal output accounting for #stats; a frame is whatever gets
+   written between two calls to tty_flush() */
+long tty_obytes = 0L;
+static long tty_oflushed = 0L, tty_oframes = 0L;
+static long tty_olast = 0L, tty_omax = 0L;
+
 static char winpanicstr[] = "Bad window id %d";
 char defmorestr[] = "--More--";
 
@@ -170,6 +178,16 @@ STATIC_DCL void FDECL(process_text_window, (winid, struct WinDesc *));
 STATIC_DCL tty_menu_item *FDECL(reverse, (tty_menu_item *));
 STATIC_DCL const char *FDECL(compress_str, (const char *));
 STATIC_DCL void FDECL(tty_putsym, (winid, int, int, CHAR_P));
+STATIC_DCL void FDECL(tty_putmbsym, (winid, int, int, const char *));
+STATIC_DCL int FDECL(tty_putmbchar, (const char *));
+
+/* will a character w columns wide starting at column x fit in a window
+   line?  (the last column is avoided to keep the terminal from wrapping) */
+#ifndef WIN32CON
+#define tty_mbfits(x, w) ((int) (x) + (w) < (int) ttyDisplay->cols)
+#else
+#define tty_mbfits(x, w) ((int) (x) + (w) <= (int) ttyDisplay->cols)
+#endif
 STATIC_DCL void FDECL(bail, (const char *)); /* __attribute__((noreturn)) */
 STATIC_DCL void FDECL(setup_rolemenu, (winid, BOOLEAN_P, int, int, int));
 STATIC_DCL void FDECL(setup_racemenu, (winid, BOOLEAN_P, int, int, int));
@@ -308,7 +326,7 @@ int sig_unused UNUSED;
                             addtopl("Press Return to continue: ");
                             break;
                         }
-                (void) fflush(stdout);
+                tty_flush();
                 if (i < 2)
                     flush_screen(1);
             }
@@ -334,7 +352,7 @@ char **argv UNUSED;
  *    due to ordering of graphics settings
  */
 #if defined(UNIX) || defined(VMS)
-    setbuf(stdout, obuf);
+    (void) setvbuf(stdout, obuf, _IOFBF, sizeof obuf);
 #endif
     gettty();
 
@@ -1187,15 +1205,15 @@ tty_askname()
 #if defined(MICRO) || defined(WIN32CON)
 #if defined(WIN32CON) || defined(MSDOS)
                     backsp(); /* \b is visible on NT */
-                    (void) putchar(' ');
+                    tty_putchar(' ');
                     backsp();
 #else
                     msmsg("\b \b");
 #endif
 #else
-                    (void) putchar('\b');
-                    (void) putchar(' ');
-                    (void) putchar('\b');
+                    tty_putchar('\b');
+                    tty_putchar(' ');
+                    tty_putchar('\b');
 #endif
                 }
                 continue;
@@ -1213,12 +1231,12 @@ tty_askname()
 #if defined(MICRO)
 #if defined(MSDOS)
                 if (iflags.grmode) {
-                    (void) putchar(c);
+                    tty_putchar(c);
                 } else
 #endif
                     msmsg("%c", c);
 #else
-                (void) putchar(c);
+                tty_putchar(c);
 #endif
                 plname[ct++] = c;
 #ifdef WIN32CON
@@ -1265,7 +1283,7 @@ const char *str;
 {
     settty(str); /* calls end_screen, perhaps raw_print */
     if (!str)
-        tty_raw_print(""); /* calls fflush(stdout) */
+        tty_raw_print(""); /* calls tty_flush() */
 }
 
 void
@@ -1322,7 +1340,7 @@ tty_create_nhwindow(type)
 int type;
 {
     struct WinDesc *newwin;
-    int i;
+    int i, n;
     int newid;
 
     if (maxwin == MAXWIN)
@@ -1351,10 +1369,12 @@ int type;
         /* sanity check */
         if (iflags.msg_history < 20)
             iflags.msg_history = 20;
-        else if (iflags.msg_history > 60)
-            iflags.msg_history = 60;
-        newwin->maxrow = newwin->rows = iflags.msg_history;
-        newwin->maxcol = newwin->cols = 0;
+        else if (iflags.msg_history > 1000)
+            iflags.msg_history = 1000;
+        newwin->rows = iflags.msg_history;
+        newwin->maxrow = newwin->maxcol = newwin->cols = 0;
+        /* history is kept by topl.c rather than in data[] */
+        init_msghistory((int) iflags.msg_history);
         break;
     case NHW_STATUS:
         /* status window, 2 lines long, full width, bottom of screen */
@@ -1409,10 +1429,12 @@ int type;
         newwin->datlen =
             (short *) alloc(sizeof(short) * (unsigned) newwin->maxrow);
         if (newwin->maxcol) {
-            /* WIN_STATUS */
+            /* WIN_STATUS; maxcol is in columns, the rows hold bytes */
             for (i = 0; i < newwin->maxrow; i++) {
-                newwin->data[i] = (char *) alloc((unsigned) newwin->maxcol);
-                newwin->datlen[i] = (short) newwin->maxcol;
+                n = MAXCOLBYTES * (int) newwin->maxcol + 1;
+                newwin->data[i] = (char *) alloc((unsigned) n);
+                newwin->data[i][0] = '\0';
+                newwin->datlen[i] = (short) n;
             }
         } else {
             for (i = 0; i < newwin->maxrow; i++) {
@@ -1420,8 +1442,6 @@ int type;
                 newwin->datlen[i] = 0;
             }
         }
-        if (newwin->type == NHW_MESSAGE)
-            newwin->maxrow = 0;
     } else {
         newwin->data = (char **) 0;
         newwin->datlen = (short *) 0;
@@ -1456,8 +1476,6 @@ boolean free_data;
     int i;
 
     if (cw->data) {
-        if (cw == wins[WIN_MESSAGE] && cw->rows > cw->maxrow)
-            cw->maxrow = cw->rows; /* topl data */
         for (i = 0; i < cw->maxrow; i++)
             if (cw->data[i]) {
                 free((genericptr_t) cw->data[i]);
@@ -1523,6 +1541,7 @@ winid window;
         cl_end();
         tty_curs(window, 1, 1);
         cl_end();
+        context.botlx = 1; /* status_update(BL_FLUSH) redraws both */
         break;
     case NHW_MAP:
         /* cheap -- clear the whole thing and tell nethack to redraw botl */
@@ -1610,7 +1629,7 @@ tty_menu_item *item;
 
     tty_curs(window, 4, lineno);
     term_start_attr(item->attr);
-    (void) putchar(ch);
+    tty_putchar(ch);
     ttyDisplay->curx++;
     term_end_attr(item->attr);
 }
@@ -1731,7 +1750,7 @@ struct WinDesc *cw;
 {
     tty_menu_item *page_start, *page_end, *curr;
     long count;
-    int n, attr_n, curr_page, page_lines, resp_len;
+    int n, k, attr_n, curr_page, page_lines, resp_len;
     boolean finished, counting, reset_count;
     char *cp, *rp, resp[QBUFSZ], gacc[QBUFSZ], *msave, *morestr, really_morc;
 #define MENU_EXPLICIT_CHOICE 0x7f /* pseudo menu manipulation char */
@@ -1811,7 +1830,7 @@ struct WinDesc *cw;
                     if (cw->offx)
                         cl_end();
 
-                    (void) putchar(' ');
+                    tty_putchar(' ');
                     ++ttyDisplay->curx;
 
                     if (!iflags.use_menu_color
@@ -1838,14 +1857,9 @@ struct WinDesc *cw;
                      * this.
                      */
                     for (n = 0, cp = curr->str;
-                         *cp &&
-#ifndef WIN32CON
-                            (int) ++ttyDisplay->curx < (int) ttyDisplay->cols;
-#else
-                            (int) ttyDisplay->curx < (int) ttyDisplay->cols;
-                         ttyDisplay->curx++,
-#endif
-                         cp++, n++) {
+                         *cp && tty_mbfits(ttyDisplay->curx,
+                                           tty_charwidth(cp));
+                         cp += k, n += k) {
                         if (n == attr_n && (color != NO_COLOR
                                             || attr != ATR_NONE))
                             toggle_menu_attr(TRUE, color, attr);
@@ -1853,11 +1867,13 @@ struct WinDesc *cw;
                             && curr->identifier.a_void != 0
                             && curr->selected) {
                             if (curr->count == -1L)
-                                (void) putchar('+'); /* all selected */
+                                tty_putchar('+'); /* all selected */
                             else
-                                (void) putchar('#'); /* count selected */
+                                tty_putchar('#'); /* count selected */
+                            ttyDisplay->curx++;
+                            k = 1;
                         } else
-                            (void) putchar(*cp);
+                            k = tty_putmbchar(cp);
                     } /* for *cp */
                     if (n > attr_n && (color != NO_COLOR || attr != ATR_NONE))
                         toggle_menu_attr(FALSE, color, attr);
@@ -2128,19 +2144,13 @@ struct WinDesc *cw;
         if (cw->data[i]) {
             attr = cw->data[i][0] - 1;
             if (cw->offx) {
-                (void) putchar(' ');
+                tty_putchar(' ');
                 ++ttyDisplay->curx;
             }
             term_start_attr(attr);
             for (cp = &cw->data[i][1];
-#ifndef WIN32CON
-                 *cp && (int) ++ttyDisplay->curx < (int) ttyDisplay->cols;
-                 cp++)
-#else
-                 *cp && (int) ttyDisplay->curx < (int) ttyDisplay->cols;
-                 cp++, ttyDisplay->curx++)
-#endif
-                (void) putchar(*cp);
+                 *cp && tty_mbfits(ttyDisplay->curx, tty_charwidth(cp));)
+                cp += tty_putmbchar(cp);
             term_end_attr(attr);
         }
     }
@@ -2200,7 +2210,7 @@ boolean blocking; /* with ttys, all windows are blocking */
         }
         /*FALLTHRU*/
     case NHW_BASE:
-        (void) fflush(stdout);
+        tty_flush();
         break;
     case NHW_TEXT:
         cw->maxcol = ttyDisplay->cols; /* force full-screen mode */
@@ -2311,8 +2321,10 @@ winid window;
 
     if (cw->active)
         tty_dismiss_nhwindow(window);
-    if (cw->type == NHW_MESSAGE)
+    if (cw->type == NHW_MESSAGE) {
         iflags.window_inited = 0;
+        free_msghistory();
+    }
     if (cw->type == NHW_MAP)
         clear_screen();
 
@@ -2393,28 +2405,31 @@ register int x, y; /* not xchar: perhaps xchar is unsigned and
         end_glyphout();
 
 #ifndef NO_TERMS
-    if (!nh_ND && (cx != x || x <= 3)) { /* Extremely primitive */
-        cmov(x, y);                      /* bunker!wtm */
-        return;
+    {
+        /* pick whichever way of getting there sends the fewest bytes */
+        int rel = nocmov_cost(cx, cy, x, y),
+            cr = 1 + nocmov_cost(0, cy, x, y),
+            abs = cmov_cost(x, y);
+
+        if (abs < MOTION_NONE && abs <= rel && abs <= cr) {
+            cmov(x, y);
+        } else if (cr < rel) {
+            tty_putchar('\r');
+            ttyDisplay->curx = 0;
+            nocmov(x, y);
+        } else
+            nocmov(x, y);
     }
-#endif
-
+#else
     if ((cy -= y) < 0)
         cy = -cy;
     if ((cx -= x) < 0)
         cx = -cx;
-    if (cy <= 3 && cx <= 3) {
-        nocmov(x, y);
-#ifndef NO_TERMS
-    } else if ((x <= 3 && cy <= 3) || (!nh_CM && x < cx)) {
-        (void) putchar('\r');
-        ttyDisplay->curx = 0;
-        nocmov(x, y);
-    } else if (!nh_CM) {
+    if (cy <= 3 && cx <= 3)
         nocmov(x, y);
-#endif
-    } else
+    else
         cmov(x, y);
+#endif
 
     ttyDisplay->curx = x;
     ttyDisplay->cury = y;
@@ -2438,7 +2453,7 @@ char ch;
     case NHW_MAP:
     case NHW_BASE:
         tty_curs(window, x, y);
-        (void) putchar(ch);
+        tty_putchar(ch);
         ttyDisplay->curx++;
         cw->curx++;
         break;
@@ -2450,6 +2465,150 @@ char ch;
     }
 }
 
+/* like tty_putsym(), for a character which may be more than one byte */
+STATIC_OVL void
+tty_putmbsym(window, x, y, s)
+winid window;
+int x, y;
+const char *s;
+{
+    register struct WinDesc *cw = 0;
+    int n = tty_charlen(s), w = tty_charwidth(s);
+
+    if (n == 1) {
+        tty_putsym(window, x, y, *s);
+        return;
+    }
+    if (window == WIN_ERR || (cw = wins[window]) == (struct WinDesc *) 0)
+        panic(winpanicstr, window);
+
+    print_vt_code2(AVTC_SELECT_WINDOW, window);
+
+    switch (cw->type) {
+    case NHW_STATUS:
+    case NHW_MAP:
+    case NHW_BASE:
+        tty_curs(window, x, y);
+        while (n-- > 0)
+            tty_putchar(*s++);
+        ttyDisplay->curx += w;
+        cw->curx += w;
+        break;
+    case NHW_MESSAGE:
+    case NHW_MENU:
+    case NHW_TEXT:
+        impossible("Can't putsym to window type %d", cw->type);
+        break;
+    }
+}
+
+/*
+ * Text in this build is UTF-8, where a character can take up to four
+ * bytes and, for CJK text, two screen columns.  Anything that isn't a
+ * well-formed sequence (IBMgraphics symbols, for instance) is taken to
+ * be a single byte one column wide.
+ */
+
+/* number of bytes in the character starting at s */
+int
+tty_charlen(s)
+const char *s;
+{
+    const unsigned char *u = (const unsigned char *) s;
+    int n, i;
+
+    if (*u < 0xC2 || *u > 0xF4)
+        return 1;
+    n = (*u >= 0xF0) ? 4 : (*u >= 0xE0) ? 3 : 2;
+    for (i = 1; i < n; i++)
+        if ((u[i] & 0xC0) != 0x80)
+            return 1;
+    return n;
+}
+
+/* number of screen columns taken by the character starting at s */
+int
+tty_charwidth(s)
+const char *s;
+{
+    const unsigned char *u = (const unsigned char *) s;
+    long c;
+
+    switch (tty_charlen(s)) {
+    case 3:
+        c = ((long) (u[0] & 0x0F) << 12) | ((long) (u[1] & 0x3F) << 6)
+            | (long) (u[2] & 0x3F);
+        break;
+    case 4:
+        return 2; /* supplementary ideographs and the like */
+    default:
+        return 1;
+    }
+    /* East Asian wide and fullwidth ranges of the BMP */
+    if ((c >= 0x1100 && c <= 0x115F) || (c >= 0x2E80 && c <= 0x303E)
+        || (c >= 0x3041 && c <= 0xA4CF) || (c >= 0xAC00 && c <= 0xD7A3)
+        || (c >= 0xF900 && c <= 0xFAFF) || (c >= 0xFE30 && c <= 0xFE4F)
+        || (c >= 0xFF00 && c <= 0xFF60) || (c >= 0xFFE0 && c <= 0xFFE6))
+        return 2;
+    return 1;
+}
+
+/* number of screen columns taken by s */
+int
+tty_strwidth(s)
+const char *s;
+{
+    register const char *p = s;
+    int width;
+
+    /* plain ASCII is one column per byte; most strings are all ASCII */
+    while (*p && !(*p & 0x80))
+        p++;
+    width = (int) (p - s);
+    while (*p) {
+        width += tty_charwidth(p);
+        p += tty_charlen(p);
+    }
+    return width;
+}
+
+/* number of bytes from the start of s that fit in cols columns without
+   splitting a character */
+int
+tty_strfit(s, cols)
+const char *s;
+int cols;
+{
+    register const char *p = s;
+    int w;
+
+    while (*p && cols > 0) {
+        if (!(*p & 0x80)) {
+            p++, cols--;
+            continue;
+        }
+        if ((w = tty_charwidth(p)) > cols)
+            break;
+        cols -= w;
+        p += tty_charlen(p);
+    }
+    return (int) (p - s);
+}
+
+/* output one possibly multibyte character at the cursor; returns its
+   length in bytes */
+STATIC_OVL int
+tty_putmbchar(s)
+const char *s;
+{
+    int i, n = tty_charlen(s);
+
+    for (i = 0; i < n; i++)
+        tty_putchar(s[i]);
+    ttyDisplay->curx += tty_charwidth(s);
+    return n;
+}
+
 STATIC_OVL const char *
 compress_str(str)
 const char *str;
@@ -2459,7 +2618,7 @@ const char *str;
     /* compress out consecutive spaces if line is too long;
        topline wrapping converts space at wrap point into newline,
        we reverse that here */
-    if ((int) strlen(str) >= CO || index(str, '\n')) {
+    if (tty_strwidth(str) >= CO || index(str, '\n')) {
         const char *in_str = str;
         char c, *outstr = cbuf, *outend = &cbuf[sizeof cbuf - 1];
         boolean was_space = TRUE; /* True discards all leading spaces;
@@ -2491,6 +2650,7 @@ const char *str;
     register char *ob;
     register const char *nb;
     register long i, j, n0;
+    int k, m, w, oc;
 
     /* Assume there's a real problem if the window is missing --
      * probably a panic message
@@ -2520,17 +2680,27 @@ const char *str;
         break;
 
     case NHW_STATUS:
-        ob = &cw->data[cw->cury][j = cw->curx];
+        /* curx is a column; the row before it was written this time
+           round, so step over that many columns to find its bytes */
+        j = tty_strfit(cw->data[cw->cury], (int) cw->curx);
+        ob = &cw->data[cw->cury][j];
         if (context.botlx)
             *ob = 0;
-        if (!cw->cury && (int) strlen(str) >= CO) {
-            /* the characters before "St:" are unnecessary */
+        if (!cw->cury && tty_strwidth(str) >= CO) {
+            /* the characters before "St:" are unnecessary; keep the
+               two columns in front of the ':' by whole characters */
             nb = index(str, ':');
-            if (nb && nb > str + 2)
-                str = nb - 2;
+            for (m = 0, oc = 0; nb && str + m < nb;
+                 m += tty_charlen(str + m))
+                oc += tty_charwidth(str + m);
+            if (oc > 2)
+                str += tty_strfit(str, oc - 2);
         }
         nb = str;
-        for (i = cw->curx + 1, n0 = cw->cols; i < n0; i++, nb++) {
+        /* i is a screen column, and oc the column of the old text at ob;
+           a character may be several bytes */
+        oc = cw->curx + 1;
+        for (i = cw->curx + 1, n0 = cw->cols; i < n0; i += w, nb += k) {
             if (!*nb) {
 #ifndef STATUS_HILITES
                 if (*ob || context.botlx) {
@@ -2548,6 +2718,10 @@ const char *str;
                 }
                 break;
             }
+            k = tty_charlen(nb);
+            w = tty_charwidth(nb);
+            if (i + w > n0)
+                break; /* a wide character that won't fit */
 #ifdef STATUS_HILITES
             /* Don't optimize the putsym away, in case it happens
                to be the same character but different color/attr.
@@ -2556,15 +2730,20 @@ const char *str;
                that option has just now been toggled off.  [We could
                do better by tracking color/attr more closely.] */
 #else
-            if (*ob != *nb)
+            if (oc != i || strncmp(ob, nb, k))
 #endif
-                tty_putsym(WIN_STATUS, i, cw->cury, *nb);
-            if (*ob)
-                ob++;
+                tty_putmbsym(WIN_STATUS, i, cw->cury, nb);
+            /* step the old text past the columns just written */
+            while (*ob && oc < i + w) {
+                oc += tty_charwidth(ob);
+                ob += tty_charlen(ob);
+            }
         }
 
-        (void) strncpy(&cw->data[cw->cury][j], str, cw->cols - j - 1);
-        cw->data[cw->cury][cw->cols - 1] = '\0'; /* null terminate */
+        /* keep what fits in the row's columns, cut between characters */
+        n0 = tty_strfit(str, (int) (cw->cols - cw->curx - 1));
+        (void) strncpy(&cw->data[cw->cury][j], str, (size_t) n0);
+        cw->data[cw->cury][j + n0] = '\0'; /* null terminate */
 #ifndef STATUS_HILITES
         cw->cury = (cw->cury + 1) % 2;
         cw->curx = 0;
@@ -2573,10 +2752,11 @@ const char *str;
     case NHW_MAP:
         tty_curs(window, cw->curx + 1, cw->cury);
         term_start_attr(attr);
-        while (*str && (int) ttyDisplay->curx < (int) ttyDisplay->cols - 1) {
-            (void) putchar(*str);
-            str++;
-            ttyDisplay->curx++;
+        while (*str && (int) ttyDisplay->curx + tty_charwidth(str)
+                           < (int) ttyDisplay->cols) {
+            for (k = tty_charlen(str), w = tty_charwidth(str); k > 0; k--)
+                tty_putchar(*str++);
+            ttyDisplay->curx += w;
         }
         cw->curx = 0;
         cw->cury++;
@@ -2586,14 +2766,15 @@ const char *str;
         tty_curs(window, cw->curx + 1, cw->cury);
         term_start_attr(attr);
         while (*str) {
-            if ((int) ttyDisplay->curx >= (int) ttyDisplay->cols - 1) {
+            w = tty_charwidth(str);
+            if ((int) ttyDisplay->curx + w > (int) ttyDisplay->cols - 1) {
                 cw->curx = 0;
                 cw->cury++;
                 tty_curs(window, cw->curx + 1, cw->cury);
             }
-            (void) putchar(*str);
-            str++;
-            ttyDisplay->curx++;
+            for (k = tty_charlen(str); k > 0; k--)
+                tty_putchar(*str++);
+            ttyDisplay->curx += w;
         }
         cw->curx = 0;
         cw->cury++;
@@ -2640,17 +2821,23 @@ const char *str;
         *ob++ = (char) (attr + 1); /* avoid nuls, for convenience */
         Strcpy(ob, str);
 
-        if (n0 > cw->maxcol)
-            cw->maxcol = n0;
+        w = tty_strwidth(str) + 1; /* maxcol is in screen columns */
+        if (w > cw->maxcol)
+            cw->maxcol = w;
         if (++cw->cury > cw->maxrow)
             cw->maxrow = cw->cury;
-        if (n0 > CO) {
+        if (w > CO) {
             /* attempt to break the line */
-            for (i = CO - 1; i && str[i] != ' ' && str[i] != '\n';)
+            for (i = k = tty_strfit(str, CO - 1);
+                 i && str[i] != ' ' && str[i] != '\n';)
                 i--;
             if (i) {
                 cw->data[cw->cury - 1][++i] = '\0';
                 tty_putstr(window, attr, &str[i]);
+            } else if (k && tty_charwidth(&str[k]) > 1) {
+                /* no spaces in CJK text; break between characters */
+                cw->data[cw->cury - 1][k + 1] = '\0';
+                tty_putstr(window, attr, &str[k]);
             }
         }
         break;
@@ -2812,6 +2999,7 @@ boolean preselected;        /* item is marked as selected */
     item->gselector = gch;
     item->attr = attr;
     item->str = dupstr(newstr ? newstr : "");
+    item->width = tty_strwidth(item->str);
 
     item->next = cw->mlist;
     cw->mlist = item;
@@ -2896,9 +3084,10 @@ const char *prompt; /* prompt to for menu */
         }
 
         /* cut off any lines that are too long */
-        len = strlen(curr->str) + 2; /* extra space at beg & end */
+        len = curr->width + 2; /* extra space at beg & end */
         if (len > (int) ttyDisplay->cols) {
-            curr->str[ttyDisplay->cols - 2] = 0;
+            curr->str[tty_strfit(curr->str, ttyDisplay->cols - 2)] = 0;
+            curr->width = tty_strwidth(curr->str);
             len = ttyDisplay->cols;
         }
         if (len > cw->cols)
@@ -3023,12 +3212,40 @@ tty_update_inventory()
     return;
 }
 
+/* push out everything written since the last call as a single write */
 void
-tty_mark_synch()
+tty_flush()
 {
+    long n = tty_obytes - tty_oflushed;
+
+    if (n > 0L) {
+        tty_oframes++;
+        tty_olast = n;
+        if (n > tty_omax)
+            tty_omax = n;
+        tty_oflushed = tty_obytes;
+    }
     (void) fflush(stdout);
 }
 
+/* for #stats; count is frames written, size is total bytes */
+void
+tty_output_stats(hdrfmt, hdrbuf, count, size)
+const char *hdrfmt;
+char *hdrbuf;
+long *count, *size;
+{
+    Sprintf(hdrbuf, hdrfmt, tty_olast, tty_omax);
+    *count = tty_oframes;
+    *size = tty_obytes;
+}
+
+void
+tty_mark_synch()
+{
+    tty_flush();
+}
+
 void
 tty_wait_synch()
 {
@@ -3041,7 +3258,7 @@ tty_wait_synch()
         tty_display_nhwindow(WIN_MAP, FALSE);
         if (ttyDisplay->inmore) {
             addtopl("--More--");
-            (void) fflush(stdout);
+            tty_flush();
         } else if (ttyDisplay->inread > program_state.gameover) {
             /* this can only happen if we were reading and got interrupted */
             ttyDisplay->toplin = 3;
@@ -3049,7 +3266,7 @@ tty_wait_synch()
             (void) tty_doprev_message();
             (void) tty_doprev_message();
             ttyDisplay->intr++;
-            (void) fflush(stdout);
+            tty_flush();
         }
     }
 }
@@ -3133,23 +3350,23 @@ int in_ch;
 #if defined(ASCIIGRAPH) && !defined(NO_TERMS)
     if (SYMHANDLING(H_IBM) || iflags.eight_bit_tty) {
         /* IBM-compatible displays don't need other stuff */
-        (void) putchar(ch);
+        tty_putchar(ch);
     } else if (ch & 0x80) {
         if (!GFlag || HE_resets_AS) {
             graph_on();
             GFlag = TRUE;
         }
-        (void) putchar((ch ^ 0x80)); /* Strip 8th bit */
+        tty_putchar((ch ^ 0x80)); /* Strip 8th bit */
     } else {
         if (GFlag) {
             graph_off();
             GFlag = FALSE;
         }
-        (void) putchar(ch);
+        tty_putchar(ch);
     }
 
 #else
-    (void) putchar(ch);
+    tty_putchar(ch);
 
 #endif /* ASCIIGRAPH && !NO_TERMS */
 
@@ -3236,7 +3453,7 @@ int bkglyph UNUSED;
 
 #ifndef NO_TERMS
     if (ul_hack && ch == '_') { /* non-destructive underscore */
-        (void) putchar((char) ' ');
+        tty_putchar((char) ' ');
         backsp();
     }
 #endif
@@ -3295,7 +3512,7 @@ const char *str;
     msmsg("%s\n", str);
 #else
     puts(str);
-    (void) fflush(stdout);
+    tty_flush();
 #endif
 }
 
@@ -3317,7 +3534,7 @@ const char *str;
     msmsg("\n");
 #else
     puts("");
-    (void) fflush(stdout);
+    tty_flush();
 #endif
 }
 
@@ -3336,7 +3553,7 @@ tty_nhgetch()
 #endif
 
     print_vt_code1(AVTC_INLINE_SYNC);
-    (void) fflush(stdout);
+    tty_flush();
     /* Note: if raw_print() and wait_synch() get called to report terminal
      * initialization problems, then wins[] and ttyDisplay might not be
      * available yet.  Such problems will probably be fatal before we get
@@ -3381,7 +3598,7 @@ int *x, *y, *mod;
 {
 #if defined(WIN32CON)
     int i;
-    (void) fflush(stdout);
+    tty_flush();
     /* Note: if raw_print() and wait_synch() get called to report terminal
      * initialization problems, then wins[] and ttyDisplay might not be
      * available yet.  Such problems will probably be fatal before we get
@@ -3443,9 +3660,25 @@ extern winid WIN_STATUS;
 static long tty_condition_bits;
 static int tty_status_colors[MAXBLSTATS];
 int hpbar_percent, hpbar_color;
+/* status lines needing redisplay at the next BL_FLUSH, one bit each */
+static int tty_status_dirty;
+static boolean tty_status_shown[MAXBLSTATS], tty_status_hpbar;
+
+#define STATUS_LINE(fld) ((fld) <= BL_SCORE ? 1 : 2)
+
+static const enum statusfields fieldorder[2][15] = {
+    { BL_TITLE, BL_STR, BL_DX, BL_CO, BL_IN, BL_WI, BL_CH, BL_ALIGN,
+      BL_SCORE, BL_FLUSH, BL_FLUSH, BL_FLUSH, BL_FLUSH, BL_FLUSH,
+      BL_FLUSH },
+    { BL_LEVELDESC, BL_GOLD, BL_HP, BL_HPMAX, BL_ENE, BL_ENEMAX,
+      BL_AC, BL_XP, BL_EXP, BL_HD, BL_TIME, BL_HUNGER,
+      BL_CAP, BL_CONDITION, BL_FLUSH }
+};
 
 static int FDECL(condcolor, (long, unsigned long *));
 static int FDECL(condattr, (long, unsigned long *));
+STATIC_DCL void FDECL(tty_status_line1, (unsigned long *));
+STATIC_DCL void FDECL(tty_status_line2, (unsigned long *));
 #endif /* STATUS_HILITES */
 
 void
@@ -3458,6 +3691,7 @@ tty_status_init()
         tty_status_colors[i] = NO_COLOR; /* no color */
     tty_condition_bits = 0L;
     hpbar_percent = 0, hpbar_color = NO_COLOR;
+    tty_status_dirty = 1 | 2;
 #endif /* STATUS_HILITES */
 
     /* let genl_status_init do most of the initialization */
@@ -3583,59 +3817,86 @@ tty_status_init()
 
 void
 tty_status_update(fldidx, ptr, chg, percent, color, colormasks)
-int fldidx, chg UNUSED, percent UNUSED, color;
+int fldidx, chg UNUSED, percent, color;
 genericptr_t ptr;
 unsigned long *colormasks;
 {
     long *condptr = (long *) ptr;
-    int i, attrmask = 0;
-#ifdef TEXTCOLOR
-    int coloridx = NO_COLOR;
-#endif
     char *text = (char *) ptr;
+    char newval[MAXCO];
     static boolean oncearound = FALSE; /* prevent premature partial display */
-    enum statusfields fieldorder[2][15] = {
-        { BL_TITLE, BL_STR, BL_DX, BL_CO, BL_IN, BL_WI, BL_CH, BL_ALIGN,
-          BL_SCORE, BL_FLUSH, BL_FLUSH, BL_FLUSH, BL_FLUSH, BL_FLUSH,
-          BL_FLUSH },
-        { BL_LEVELDESC, BL_GOLD, BL_HP, BL_HPMAX, BL_ENE, BL_ENEMAX,
-          BL_AC, BL_XP, BL_EXP, BL_HD, BL_TIME, BL_HUNGER,
-          BL_CAP, BL_CONDITION, BL_FLUSH }
-    };
-    int attridx = 0;
 
+#ifndef TEXTCOLOR
+    color = NO_COLOR;
+#endif
+    /*
+     * Field updates are only recorded here, noting which of the two
+     * lines now differs from what is on the screen; the lines that do
+     * are redrawn when the core follows up with BL_FLUSH.
+     */
     if (fldidx != BL_FLUSH) {
         if (!status_activefields[fldidx])
             return;
         switch (fldidx) {
         case BL_CONDITION:
+            if (tty_condition_bits != *condptr)
+                tty_status_dirty |= STATUS_LINE(fldidx);
             tty_condition_bits = *condptr;
             oncearound = TRUE;
             break;
         default:
-            Sprintf(status_vals[fldidx],
+            Sprintf(newval,
                     (fldidx == BL_TITLE && iflags.wc2_hitpointbar) ? "%-30s" :
                     status_fieldfmt[fldidx] ? status_fieldfmt[fldidx] : "%s",
                     text);
-#ifdef TEXTCOLOR
-            tty_status_colors[fldidx] = color;
-#else
-            tty_status_colors[fldidx] = NO_COLOR;
-#endif
-            if (iflags.wc2_hitpointbar && fldidx == BL_HP) {
+            if (strcmp(status_vals[fldidx], newval)
+                || tty_status_colors[fldidx] != color) {
+                Strcpy(status_vals[fldidx], newval);
+                tty_status_colors[fldidx] = color;
+                tty_status_dirty |= STATUS_LINE(fldidx);
+            }
+            if (iflags.wc2_hitpointbar && fldidx == BL_HP
+                && (hpbar_percent != percent || hpbar_color != color)) {
                 hpbar_percent = percent;
-#ifdef TEXTCOLOR
                 hpbar_color = color;
-#else
-                hpbar_color = NO_COLOR;
-#endif
+                tty_status_dirty |= STATUS_LINE(BL_TITLE);
             }
             break;
         }
+        return;
     }
 
     if (!oncearound) return;
 
+    /* the lines were overwritten, or the set of fields changed */
+    if (context.botlx || tty_status_hpbar != iflags.wc2_hitpointbar
+        || memcmp((genericptr_t) tty_status_shown,
+                  (genericptr_t) status_activefields,
+                  sizeof tty_status_shown)) {
+        tty_status_dirty = 1 | 2;
+        tty_status_hpbar = iflags.wc2_hitpointbar;
+        (void) memcpy((genericptr_t) tty_status_shown,
+                      (genericptr_t) status_activefields,
+                      sizeof tty_status_shown);
+    }
+    if (tty_status_dirty & 1)
+        tty_status_line1(colormasks);
+    if (tty_status_dirty & 2)
+        tty_status_line2(colormasks);
+    tty_status_dirty = 0;
+    return;
+}
+
+STATIC_OVL void
+tty_status_line1(colormasks)
+unsigned long *colormasks UNUSED;
+{
+    int i, attridx = 0;
+#ifdef TEXTCOLOR
+    int coloridx = NO_COLOR;
+#endif
+    char *text;
+
     curs(WIN_STATUS, 1, 0);
     for (i = 0; fieldorder[0][i] != BL_FLUSH; ++i) {
         int fldidx1 = fieldorder[0][i];
@@ -3678,12 +3939,16 @@ unsigned long *colormasks;
                 text = status_vals[fldidx1];
                 bar_len = strlen(text);
                 if (bar_len < MAXCO-1) {
+                    int bar_cols = tty_strwidth(text);
+
                     Strcpy(bar, text);
-                    bar_pos = (bar_len * hpbar_percent) / 100;
+                    bar_pos = (bar_cols * hpbar_percent) / 100;
                     if (bar_pos < 1 && hpbar_percent > 0)
                         bar_pos = 1;
-                    if (bar_pos >= bar_len && hpbar_percent < 100)
-                        bar_pos = bar_len - 1;
+                    if (bar_pos >= bar_cols && hpbar_percent < 100)
+                        bar_pos = bar_cols - 1;
+                    /* split between characters, not inside one */
+                    bar_pos = tty_strfit(bar, bar_pos);
                     if (bar_pos > 0 && bar_pos < bar_len) {
                         twoparts = TRUE;
                         bar2 = &bar[bar_pos];
@@ -3717,6 +3982,18 @@ unsigned long *colormasks;
         }
     }
     cl_end();
+}
+
+STATIC_OVL void
+tty_status_line2(colormasks)
+unsigned long *colormasks;
+{
+    int i, attrmask = 0, attridx = 0;
+#ifdef TEXTCOLOR
+    int coloridx = NO_COLOR;
+#endif
+    char *text;
+
     curs(WIN_STATUS, 1, 1);
     for (i = 0; fieldorder[1][i] != BL_FLUSH; ++i) {
         int fldidx2 = fieldorder[1][i];